@@ -0,0 +1,172 @@
+#include "bitgrid.h"
+#include "bitslice.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int tail_bits(const BitGrid *g) {
+    int tail = g->cols % 64;
+    return tail ? tail : 64;
+}
+
+static uint64_t *row_ptr(const BitGrid *g, int y) {
+    return g->words + (size_t)y * g->words_per_row;
+}
+
+int bitgrid_init(BitGrid *g, int cols, int rows) {
+    memset(g, 0, sizeof(*g));
+    if (cols < 1 || rows < 1)
+        return -1;
+    g->cols = cols;
+    g->rows = rows;
+    g->words_per_row = (cols + 63) / 64;
+    g->words = calloc((size_t)g->words_per_row * rows, sizeof(uint64_t));
+    return g->words ? 0 : -1;
+}
+
+void bitgrid_free(BitGrid *g) {
+    free(g->words);
+    memset(g, 0, sizeof(*g));
+}
+
+void bitgrid_load(BitGrid *g, const CellState *cells) {
+    memset(g->words, 0, (size_t)g->words_per_row * g->rows * sizeof(uint64_t));
+    for (int y = 0; y < g->rows; y++) {
+        uint64_t *row = row_ptr(g, y);
+        const CellState *src = cells + (size_t)y * g->cols;
+        for (int x = 0; x < g->cols; x++)
+            row[x / 64] |= (uint64_t)(src[x] == ALIVE) << (x % 64);
+    }
+}
+
+void bitgrid_store(const BitGrid *g, CellState *cells) {
+    for (int y = 0; y < g->rows; y++) {
+        const uint64_t *row = row_ptr(g, y);
+        CellState *dst = cells + (size_t)y * g->cols;
+        for (int x = 0; x < g->cols; x++)
+            dst[x] = (row[x / 64] >> (x % 64)) & 1 ? ALIVE : DEAD;
+    }
+}
+
+CellState bitgrid_get(const BitGrid *g, int x, int y) {
+    x = (x % g->cols + g->cols) % g->cols;
+    y = (y % g->rows + g->rows) % g->rows;
+    return (row_ptr(g, y)[x / 64] >> (x % 64)) & 1 ? ALIVE : DEAD;
+}
+
+void bitgrid_set(BitGrid *g, int x, int y, CellState state) {
+    x = (x % g->cols + g->cols) % g->cols;
+    y = (y % g->rows + g->rows) % g->rows;
+    uint64_t bit = 1ULL << (x % 64);
+    uint64_t *word = &row_ptr(g, y)[x / 64];
+    *word = state == ALIVE ? *word | bit : *word & ~bit;
+}
+
+// One row of words per circuit register.
+size_t bitgrid_scratch_words(const BitGrid *g) {
+    return (size_t)RULE_CIRCUIT_MAX_REGS * g->words_per_row;
+}
+
+// Word w with every cell replaced by its western (x - 1) neighbor.
+static uint64_t shift_west(const uint64_t *row, int w, int last, int tail) {
+    uint64_t carry = w ? row[w - 1] >> 63 : (row[last] >> (tail - 1)) & 1;
+    return (row[w] << 1) | carry;
+}
+
+// Word w with every cell replaced by its eastern (x + 1) neighbor.
+static uint64_t shift_east(const uint64_t *row, int w, int last, int tail) {
+    uint64_t carry = w < last ? row[w + 1] << 63 : (row[0] & 1) << (tail - 1);
+    return (row[w] >> 1) | carry;
+}
+
+// Evaluates the rule on the count and state rows in scratch and stores row y.
+static void finish_row(const RuleCircuit *circuit, uint64_t *scratch, BitGrid *next, int y) {
+    int wpr = next->words_per_row, tail = tail_bits(next);
+    const uint64_t *result = rule_circuit_eval_rows(circuit, scratch, wpr);
+    uint64_t *out = row_ptr(next, y);
+    memcpy(out, result, wpr * sizeof(uint64_t));
+    out[wpr - 1] &= tail == 64 ? ~0ULL : (1ULL << tail) - 1;
+}
+
+void bitgrid_step(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit, uint64_t *scratch) {
+    int wpr = curr->words_per_row, last = wpr - 1, tail = tail_bits(curr);
+
+    for (int y = 0; y < curr->rows; y++) {
+        const uint64_t *up = row_ptr(curr, y == 0 ? curr->rows - 1 : y - 1);
+        const uint64_t *mid = row_ptr(curr, y);
+        const uint64_t *down = row_ptr(curr, y == curr->rows - 1 ? 0 : y + 1);
+
+        for (int w = 0; w < wpr; w++) {
+            uint64_t n[8] = {
+                shift_west(up, w, last, tail), up[w], shift_east(up, w, last, tail),
+                shift_west(mid, w, last, tail), shift_east(mid, w, last, tail),
+                shift_west(down, w, last, tail), down[w], shift_east(down, w, last, tail),
+            };
+            bs_count8(n, &scratch[RC_B0 * wpr + w], &scratch[RC_B1 * wpr + w],
+                      &scratch[RC_B2 * wpr + w], &scratch[RC_B3 * wpr + w]);
+            scratch[RC_ALIVE * wpr + w] = mid[w];
+        }
+        finish_row(circuit, scratch, next, y);
+    }
+}
+
+// Six neighbors: west, east, and two cells in each adjacent row, shifted
+// towards the west on even rows and towards the east on odd rows. With an odd
+// row count the offsets would not line up across the wrap, so that is refused.
+int bitgrid_step_hex(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit, uint64_t *scratch) {
+    if (curr->rows % 2 != 0)
+        return -1;
+    int wpr = curr->words_per_row, last = wpr - 1, tail = tail_bits(curr);
+
+    for (int y = 0; y < curr->rows; y++) {
+        const uint64_t *up = row_ptr(curr, y == 0 ? curr->rows - 1 : y - 1);
+        const uint64_t *mid = row_ptr(curr, y);
+        const uint64_t *down = row_ptr(curr, y == curr->rows - 1 ? 0 : y + 1);
+        int odd = y & 1;
+
+        for (int w = 0; w < wpr; w++) {
+            uint64_t up_side = odd ? shift_east(up, w, last, tail) : shift_west(up, w, last, tail);
+            uint64_t down_side = odd ? shift_east(down, w, last, tail) : shift_west(down, w, last, tail);
+            uint64_t s1, c1, s2, c2, k;
+            bs_full_add(shift_west(mid, w, last, tail), shift_east(mid, w, last, tail), up[w], &s1, &c1);
+            bs_full_add(up_side, down[w], down_side, &s2, &c2);
+            bs_half_add(s1, s2, &scratch[RC_B0 * wpr + w], &k);
+            bs_full_add(c1, c2, k, &scratch[RC_B1 * wpr + w], &scratch[RC_B2 * wpr + w]);
+            scratch[RC_B3 * wpr + w] = 0;
+            scratch[RC_ALIVE * wpr + w] = mid[w];
+        }
+        finish_row(circuit, scratch, next, y);
+    }
+    return 0;
+}
+
+// Four orthogonal neighbors.
+void bitgrid_step_von_neumann(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit, uint64_t *scratch) {
+    int wpr = curr->words_per_row, last = wpr - 1, tail = tail_bits(curr);
+
+    for (int y = 0; y < curr->rows; y++) {
+        const uint64_t *up = row_ptr(curr, y == 0 ? curr->rows - 1 : y - 1);
+        const uint64_t *mid = row_ptr(curr, y);
+        const uint64_t *down = row_ptr(curr, y == curr->rows - 1 ? 0 : y + 1);
+
+        for (int w = 0; w < wpr; w++) {
+            uint64_t s, c, k;
+            bs_full_add(shift_west(mid, w, last, tail), shift_east(mid, w, last, tail), up[w], &s, &c);
+            bs_half_add(s, down[w], &scratch[RC_B0 * wpr + w], &k);
+            bs_half_add(c, k, &scratch[RC_B1 * wpr + w], &scratch[RC_B2 * wpr + w]);
+            scratch[RC_B3 * wpr + w] = 0;
+            scratch[RC_ALIVE * wpr + w] = mid[w];
+        }
+        finish_row(circuit, scratch, next, y);
+    }
+}
+
+// Returns -1 if the grid cannot use the neighborhood; next is then untouched.
+int bitgrid_step_neighborhood(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit,
+                              Neighborhood neighborhood, uint64_t *scratch) {
+    switch (neighborhood) {
+    case NEIGHBORHOOD_MOORE: bitgrid_step(curr, next, circuit, scratch); return 0;
+    case NEIGHBORHOOD_HEX: return bitgrid_step_hex(curr, next, circuit, scratch);
+    case NEIGHBORHOOD_VON_NEUMANN: bitgrid_step_von_neumann(curr, next, circuit, scratch); return 0;
+    }
+    return -1;
+}
@@ -0,0 +1,41 @@
+#ifndef BITGRID_H
+#define BITGRID_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "game_core.h"
+#include "rule_circuit.h"
+
+// Cells counted as neighbors. HEX is the offset-row layout: odd rows sit
+// half a cell to the right, so a cell touches two cells in each adjacent row
+// (x - 1 and x on even rows, x and x + 1 on odd rows). A hexagonal torus
+// needs an even number of rows; the hex step returns -1 for an odd count.
+typedef enum {
+    NEIGHBORHOOD_MOORE = 0,
+    NEIGHBORHOOD_HEX = 1,
+    NEIGHBORHOOD_VON_NEUMANN = 2
+} Neighborhood;
+
+// Toroidal grid packed one cell per bit, 64 cells per word. Each row starts
+// on a fresh word; padding bits past cols in the last word are kept zero.
+typedef struct {
+    int cols;
+    int rows;
+    int words_per_row;
+    uint64_t *words;
+} BitGrid;
+
+int bitgrid_init(BitGrid *g, int cols, int rows);
+void bitgrid_free(BitGrid *g);
+void bitgrid_load(BitGrid *g, const CellState *cells);
+void bitgrid_store(const BitGrid *g, CellState *cells);
+CellState bitgrid_get(const BitGrid *g, int x, int y);
+void bitgrid_set(BitGrid *g, int x, int y, CellState state);
+size_t bitgrid_scratch_words(const BitGrid *g);
+void bitgrid_step(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit, uint64_t *scratch);
+int bitgrid_step_hex(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit, uint64_t *scratch);
+void bitgrid_step_von_neumann(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit, uint64_t *scratch);
+int bitgrid_step_neighborhood(const BitGrid *curr, BitGrid *next, const RuleCircuit *circuit,
+                              Neighborhood neighborhood, uint64_t *scratch);
+
+#endif
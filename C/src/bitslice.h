@@ -0,0 +1,32 @@
+#ifndef BITSLICE_H
+#define BITSLICE_H
+
+#include <stdint.h>
+
+// Bitsliced arithmetic: every bit position of a word is an independent lane,
+// so one call adds 64 cells (or 64 boards) at once.
+
+static inline void bs_half_add(uint64_t a, uint64_t b, uint64_t *sum, uint64_t *carry) {
+    *sum = a ^ b;
+    *carry = a & b;
+}
+
+static inline void bs_full_add(uint64_t a, uint64_t b, uint64_t c, uint64_t *sum, uint64_t *carry) {
+    uint64_t t = a ^ b;
+    *sum = t ^ c;
+    *carry = (a & b) | (t & c);
+}
+
+// Counts eight neighbor lanes into a 4-bit binary number (b3 is set only for 8).
+static inline void bs_count8(const uint64_t n[8], uint64_t *b0, uint64_t *b1, uint64_t *b2, uint64_t *b3) {
+    uint64_t s1, c1, s2, c2, s3, c3, k1, t, u, v;
+    bs_full_add(n[0], n[1], n[2], &s1, &c1);
+    bs_full_add(n[3], n[4], n[5], &s2, &c2);
+    bs_half_add(n[6], n[7], &s3, &c3);
+    bs_full_add(s1, s2, s3, b0, &k1);
+    bs_full_add(c1, c2, c3, &t, &u);
+    bs_half_add(t, k1, b1, &v);
+    bs_half_add(u, v, b2, b3);
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "change_ring.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define CACHE_LINE 64
+
+// head and tail sit on their own cache lines, each next to the cached copy of
+// the other index kept by the same side, so steady-state pushes and pops only
+// touch shared lines when the cached view says full or empty.
+struct ChangeRing {
+    _Alignas(CACHE_LINE) atomic_size_t tail;  // next slot to write
+    size_t head_cache;                        // producer's last view of head
+    atomic_uint_fast64_t dropped;
+    _Alignas(CACHE_LINE) atomic_size_t head;  // next slot to read
+    size_t tail_cache;                        // consumer's last view of tail
+    _Alignas(CACHE_LINE) size_t mask;
+    ChangeRun *runs;
+};
+
+// capacity is rounded up to a power of two. It must be at least 2, since one
+// slot is reserved for end-of-generation records (see change_ring_push).
+ChangeRing *change_ring_create(size_t capacity) {
+    if (capacity < 2 || capacity > ((size_t)1 << 40))
+        return NULL;
+    size_t n = 1;
+    while (n < capacity)
+        n <<= 1;
+    ChangeRing *ring = aligned_alloc(CACHE_LINE, sizeof(ChangeRing));
+    if (!ring)
+        return NULL;
+    ring->runs = malloc(n * sizeof(ChangeRun));
+    if (!ring->runs) {
+        free(ring);
+        return NULL;
+    }
+    ring->mask = n - 1;
+    ring->head_cache = 0;
+    ring->tail_cache = 0;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->dropped, 0);
+    return ring;
+}
+
+void change_ring_destroy(ChangeRing *ring) {
+    if (!ring)
+        return;
+    free(ring->runs);
+    free(ring);
+}
+
+size_t change_ring_capacity(const ChangeRing *ring) {
+    return ring->mask + 1;
+}
+
+// Producer only. Returns -1 and counts the run as dropped when the ring is full.
+// The last free slot is kept for an end-of-generation record, so a generation
+// that overflows still closes and the consumer never merges two of them.
+int change_ring_push(ChangeRing *ring, const ChangeRun *run) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t limit = run->kind == CHANGE_END_OF_GENERATION ? ring->mask + 1 : ring->mask;
+    if (tail - ring->head_cache >= limit) {
+        ring->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail - ring->head_cache >= limit) {
+            atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+            return -1;
+        }
+    }
+    ring->runs[tail & ring->mask] = *run;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+// Consumer only. Copies out up to max_runs records and returns how many.
+size_t change_ring_pop(ChangeRing *ring, ChangeRun *out, size_t max_runs) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (ring->tail_cache - head < max_runs)
+        ring->tail_cache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t n = ring->tail_cache - head;
+    if (n > max_runs)
+        n = max_runs;
+    for (size_t i = 0; i < n; i++)
+        out[i] = ring->runs[(head + i) & ring->mask];
+    atomic_store_explicit(&ring->head, head + n, memory_order_release);
+    return n;
+}
+
+uint64_t change_ring_dropped(const ChangeRing *ring) {
+    return atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+}
@@ -0,0 +1,35 @@
+#ifndef CHANGE_RING_H
+#define CHANGE_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    CHANGE_BIRTH = 0,
+    CHANGE_DEATH = 1,
+    CHANGE_END_OF_GENERATION = 2  // closes a generation; length counts runs dropped in it
+} ChangeKind;
+
+// length consecutive cells of row y, starting at x, that all changed the
+// same way between generation - 1 and generation.
+typedef struct {
+    uint32_t generation;
+    uint16_t x;
+    uint16_t y;
+    uint16_t length;
+    uint8_t kind;
+} ChangeRun;
+
+// Lock-free single-producer single-consumer queue of ChangeRun records. The
+// producer never waits: a run that does not fit is dropped and counted. One
+// slot is reserved for end-of-generation records, which other runs never use.
+typedef struct ChangeRing ChangeRing;
+
+ChangeRing *change_ring_create(size_t capacity);
+void change_ring_destroy(ChangeRing *ring);
+size_t change_ring_capacity(const ChangeRing *ring);
+int change_ring_push(ChangeRing *ring, const ChangeRun *run);
+size_t change_ring_pop(ChangeRing *ring, ChangeRun *out, size_t max_runs);
+uint64_t change_ring_dropped(const ChangeRing *ring);
+
+#endif
@@ -0,0 +1,136 @@
+#include "eca.h"
+#include "random_fill.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Accepts "W30" (Golly's notation) or a bare "30".
+int eca_rule_parse(uint8_t *rule, const char *rulestring) {
+    const char *s = toupper((unsigned char)rulestring[0]) == 'W' ? rulestring + 1 : rulestring;
+    char *end;
+    long n = strtol(s, &end, 10);
+    if (end == s || *end || !isdigit((unsigned char)*s) || n > 255)
+        return -1;
+    *rule = (uint8_t)n;
+    return 0;
+}
+
+int eca_init(Eca *eca, int width, uint8_t rule) {
+    memset(eca, 0, sizeof(*eca));
+    if (width < 1)
+        return -1;
+    eca->width = width;
+    eca->n_words = (width + 63) / 64;
+    eca->rule = rule;
+    eca->cells = calloc(eca->n_words, sizeof(uint64_t));
+    eca->scratch = calloc(eca->n_words, sizeof(uint64_t));
+    if (!eca->cells || !eca->scratch) {
+        eca_free(eca);
+        return -1;
+    }
+    return 0;
+}
+
+void eca_free(Eca *eca) {
+    free(eca->cells);
+    free(eca->scratch);
+    memset(eca, 0, sizeof(*eca));
+}
+
+CellState eca_get(const Eca *eca, int x) {
+    x = (x % eca->width + eca->width) % eca->width;
+    return (eca->cells[x / 64] >> (x % 64)) & 1 ? ALIVE : DEAD;
+}
+
+void eca_set(Eca *eca, int x, CellState state) {
+    x = (x % eca->width + eca->width) % eca->width;
+    uint64_t bit = 1ULL << (x % 64);
+    eca->cells[x / 64] = state == ALIVE ? eca->cells[x / 64] | bit : eca->cells[x / 64] & ~bit;
+}
+
+void eca_seed_center(Eca *eca) {
+    memset(eca->cells, 0, eca->n_words * sizeof(uint64_t));
+    eca_set(eca, eca->width / 2, ALIVE);
+}
+
+// Cell x takes cell x of random_fill's output, so a seed gives the same ring
+// on any thread count. Returns -1 if the row buffer cannot be allocated.
+int eca_randomize(Eca *eca, double density, uint64_t seed) {
+    CellState *row = malloc(eca->width * sizeof(CellState));
+    if (!row)
+        return -1;
+    random_fill(row, eca->width, density, seed);
+    memset(eca->cells, 0, eca->n_words * sizeof(uint64_t));
+    for (int x = 0; x < eca->width; x++) {
+        if (row[x] == ALIVE)
+            eca->cells[x / 64] |= 1ULL << (x % 64);
+    }
+    free(row);
+    return 0;
+}
+
+// The rule as a 3-level multiplexer over (left, center, right): k[i] is
+// all-ones when bit i of the rule is set, so every op works on 64 cells.
+static inline uint64_t apply_rule(uint64_t l, uint64_t c, uint64_t r, const uint64_t k[8]) {
+    uint64_t a0 = (r & k[1]) | (~r & k[0]);
+    uint64_t a1 = (r & k[3]) | (~r & k[2]);
+    uint64_t a2 = (r & k[5]) | (~r & k[4]);
+    uint64_t a3 = (r & k[7]) | (~r & k[6]);
+    uint64_t b0 = (c & a1) | (~c & a0);
+    uint64_t b1 = (c & a3) | (~c & a2);
+    return (l & b1) | (~l & b0);
+}
+
+void eca_step(Eca *eca) {
+    const uint64_t *cur = eca->cells;
+    uint64_t *out = eca->scratch;
+    int last = eca->n_words - 1, tail = eca->width % 64 ? eca->width % 64 : 64;
+    uint64_t tail_mask = tail == 64 ? ~0ULL : (1ULL << tail) - 1;
+    uint64_t k[8];
+    for (int i = 0; i < 8; i++)
+        k[i] = (eca->rule >> i) & 1 ? ~0ULL : 0;
+
+    // Bit x holds cell x, so the left neighbor arrives by shifting up.
+    uint64_t wrap_left = (cur[last] >> (tail - 1)) & 1;
+    uint64_t wrap_right = (cur[0] & 1) << (tail - 1);
+    if (last == 0) {
+        out[0] = apply_rule((cur[0] << 1) | wrap_left, cur[0], (cur[0] >> 1) | wrap_right, k);
+    } else {
+        out[0] = apply_rule((cur[0] << 1) | wrap_left, cur[0], (cur[0] >> 1) | (cur[1] << 63), k);
+        for (int w = 1; w < last; w++)
+            out[w] = apply_rule((cur[w] << 1) | (cur[w - 1] >> 63), cur[w], (cur[w] >> 1) | (cur[w + 1] << 63), k);
+        out[last] = apply_rule((cur[last] << 1) | (cur[last - 1] >> 63), cur[last], (cur[last] >> 1) | wrap_right, k);
+    }
+    out[last] &= tail_mask;
+
+    eca->scratch = eca->cells;
+    eca->cells = out;
+    eca->generation++;
+}
+
+void eca_run(Eca *eca, long generations) {
+    for (long i = 0; i < generations; i++)
+        eca_step(eca);
+}
+
+// Writes the first cols cells; columns past the ring's width stay dead.
+void eca_store_row(const Eca *eca, CellState *row, int cols) {
+    for (int x = 0; x < cols; x++)
+        row[x] = x < eca->width && (eca->cells[x / 64] >> (x % 64)) & 1 ? ALIVE : DEAD;
+}
+
+// Space-time diagram: row y of the grid is the current state after y steps.
+void eca_diagram(Eca *eca, CellState *grid, int cols, int rows) {
+    for (int y = 0; y < rows; y++) {
+        if (y)
+            eca_step(eca);
+        eca_store_row(eca, grid + (size_t)y * cols, cols);
+    }
+}
+
+// Scrolls the diagram up one row and appends the next generation.
+void eca_scroll(Eca *eca, CellState *grid, int cols, int rows) {
+    memmove(grid, grid + cols, (size_t)(rows - 1) * cols * sizeof(CellState));
+    eca_step(eca);
+    eca_store_row(eca, grid + (size_t)(rows - 1) * cols, cols);
+}
@@ -0,0 +1,32 @@
+#ifndef ECA_H
+#define ECA_H
+
+#include <stdint.h>
+#include "game_core.h"
+
+// Wolfram elementary cellular automaton on a ring of `width` cells, packed
+// 64 cells per word. Bit k of the rule number is the next state for the
+// neighborhood (left, center, right) = binary k.
+typedef struct {
+    int width;
+    int n_words;
+    uint8_t rule;
+    long generation;
+    uint64_t *cells;
+    uint64_t *scratch;
+} Eca;
+
+int eca_rule_parse(uint8_t *rule, const char *rulestring);
+int eca_init(Eca *eca, int width, uint8_t rule);
+void eca_free(Eca *eca);
+CellState eca_get(const Eca *eca, int x);
+void eca_set(Eca *eca, int x, CellState state);
+void eca_seed_center(Eca *eca);
+int eca_randomize(Eca *eca, double density, uint64_t seed);
+void eca_step(Eca *eca);
+void eca_run(Eca *eca, long generations);
+void eca_store_row(const Eca *eca, CellState *row, int cols);
+void eca_diagram(Eca *eca, CellState *grid, int cols, int rows);
+void eca_scroll(Eca *eca, CellState *grid, int cols, int rows);
+
+#endif
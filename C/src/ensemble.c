@@ -0,0 +1,177 @@
+#include "ensemble.h"
+#include "bitslice.h"
+#include <stdlib.h>
+#include <string.h>
+
+static size_t board_cells(const Ensemble *e) {
+    return (size_t)e->cols * e->rows;
+}
+
+// Slot k relative to the group's phase: 0 = curr, 1 = next, 2 = prev.
+static uint64_t *group_slot(const Ensemble *e, int group, int k) {
+    int slot = (e->phase[group] + k) % 3;
+    return e->planes + ((size_t)group * 3 + slot) * board_cells(e);
+}
+
+int ensemble_init(Ensemble *e, int cols, int rows, int n_boards) {
+    memset(e, 0, sizeof(*e));
+    if (cols < 1 || rows < 1 || n_boards < 1)
+        return -1;
+
+    e->cols = cols;
+    e->rows = rows;
+    e->n_boards = n_boards;
+    e->n_groups = (n_boards + ENSEMBLE_LANES - 1) / ENSEMBLE_LANES;
+
+    size_t plane_bytes = (size_t)e->n_groups * 3 * board_cells(e) * sizeof(uint64_t);
+    void *planes = NULL;
+    if (posix_memalign(&planes, 64, plane_bytes) != 0)
+        return -1;
+    e->planes = planes;
+    memset(e->planes, 0, plane_bytes);
+
+    e->phase = calloc(e->n_groups, sizeof(uint8_t));
+    e->active = calloc(e->n_groups, sizeof(uint64_t));
+    e->settled_at = malloc((size_t)n_boards * sizeof(int));
+    e->x_left = malloc((size_t)cols * sizeof(int));
+    e->x_right = malloc((size_t)cols * sizeof(int));
+    e->y_up = malloc((size_t)rows * sizeof(int));
+    e->y_down = malloc((size_t)rows * sizeof(int));
+    e->regs = malloc((size_t)RULE_CIRCUIT_MAX_REGS * cols * sizeof(uint64_t));
+    if (!e->regs || !e->phase || !e->active || !e->settled_at || !e->x_left || !e->x_right || !e->y_up || !e->y_down) {
+        ensemble_free(e);
+        return -1;
+    }
+
+    for (int x = 0; x < cols; x++) {
+        e->x_left[x] = (x + cols - 1) % cols;
+        e->x_right[x] = (x + 1) % cols;
+    }
+    for (int y = 0; y < rows; y++) {
+        e->y_up[y] = (y + rows - 1) % rows * cols;
+        e->y_down[y] = (y + 1) % rows * cols;
+    }
+
+    ensemble_set_rule(e, &LIFE_RULE_CONWAY);
+    return 0;
+}
+
+void ensemble_free(Ensemble *e) {
+    free(e->planes);
+    free(e->phase);
+    free(e->active);
+    free(e->settled_at);
+    free(e->x_left);
+    free(e->x_right);
+    free(e->y_up);
+    free(e->y_down);
+    free(e->regs);
+    memset(e, 0, sizeof(*e));
+}
+
+// Boards that settled under the old rule may evolve under the new one, so
+// every board becomes active again.
+void ensemble_set_rule(Ensemble *e, const LifeRule *rule) {
+    e->rule = *rule;
+    rule_circuit_compile(&e->circuit, rule);
+    memset(e->active, 0, (size_t)e->n_groups * sizeof(uint64_t));
+    for (int b = 0; b < e->n_boards; b++) {
+        e->settled_at[b] = -1;
+        e->active[b / ENSEMBLE_LANES] |= 1ULL << (b % ENSEMBLE_LANES);
+    }
+    e->n_active = e->n_boards;
+}
+
+void ensemble_set_board(Ensemble *e, int board, const CellState *grid) {
+    int group = board / ENSEMBLE_LANES;
+    uint64_t bit = 1ULL << (board % ENSEMBLE_LANES);
+    uint64_t *curr = group_slot(e, group, 0);
+    uint64_t *prev = group_slot(e, group, 2);
+
+    for (size_t i = 0; i < board_cells(e); i++) {
+        if (grid[i] == ALIVE)
+            curr[i] |= bit;
+        else
+            curr[i] &= ~bit;
+        prev[i] = (prev[i] & ~bit) | (curr[i] & bit);
+    }
+
+    if (!(e->active[group] & bit))
+        e->n_active++;
+    e->active[group] |= bit;
+    e->settled_at[board] = -1;
+}
+
+void ensemble_get_board(const Ensemble *e, int board, CellState *grid) {
+    int group = board / ENSEMBLE_LANES;
+    uint64_t bit = 1ULL << (board % ENSEMBLE_LANES);
+    const uint64_t *curr = group_slot(e, group, 0);
+
+    for (size_t i = 0; i < board_cells(e); i++)
+        grid[i] = (curr[i] & bit) ? ALIVE : DEAD;
+}
+
+static void step_group(Ensemble *e, int group) {
+    const uint64_t *curr = group_slot(e, group, 0);
+    uint64_t *next = group_slot(e, group, 1);
+    const uint64_t *prev = group_slot(e, group, 2);
+    uint64_t active = e->active[group];
+    uint64_t changed = 0, changed_from_prev = 0;
+    int cols = e->cols;
+
+    for (int y = 0; y < e->rows; y++) {
+        const uint64_t *up = curr + e->y_up[y];
+        const uint64_t *mid = curr + (size_t)y * cols;
+        const uint64_t *down = curr + e->y_down[y];
+        for (int x = 0; x < cols; x++) {
+            int xl = e->x_left[x], xr = e->x_right[x];
+            uint64_t n[8] = {up[xl], up[x], up[xr], mid[xl], mid[xr], down[xl], down[x], down[xr]};
+            bs_count8(n, &e->regs[RC_B0 * cols + x], &e->regs[RC_B1 * cols + x],
+                      &e->regs[RC_B2 * cols + x], &e->regs[RC_B3 * cols + x]);
+            e->regs[RC_ALIVE * cols + x] = mid[x];
+        }
+
+        const uint64_t *result = rule_circuit_eval_rows(&e->circuit, e->regs, cols);
+        uint64_t *out = next + (size_t)y * cols;
+        const uint64_t *before = prev + (size_t)y * cols;
+        for (int x = 0; x < cols; x++) {
+            // Settled lanes keep their state
+            uint64_t new_state = (result[x] & active) | (mid[x] & ~active);
+            out[x] = new_state;
+            changed |= new_state ^ mid[x];
+            changed_from_prev |= new_state ^ before[x];
+        }
+    }
+
+    e->phase[group] = (e->phase[group] + 1) % 3;
+
+    // Still lifes and period-2 oscillators are done
+    uint64_t settled = active & (~changed | ~changed_from_prev);
+    e->active[group] = active & ~settled;
+    while (settled) {
+        int lane = __builtin_ctzll(settled);
+        e->settled_at[group * ENSEMBLE_LANES + lane] = e->generation + 1;
+        e->n_active--;
+        settled &= settled - 1;
+    }
+}
+
+int ensemble_step(Ensemble *e) {
+    for (int g = 0; g < e->n_groups; g++) {
+        if (e->active[g])
+            step_group(e, g);
+    }
+    e->generation++;
+    return e->n_active;
+}
+
+int ensemble_run(Ensemble *e, int max_generations) {
+    int start = e->generation;
+    while (e->n_active > 0 && e->generation - start < max_generations)
+        ensemble_step(e);
+    return e->generation - start;
+}
+
+int ensemble_board_active(const Ensemble *e, int board) {
+    return (e->active[board / ENSEMBLE_LANES] >> (board % ENSEMBLE_LANES)) & 1;
+}
@@ -0,0 +1,41 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <stdint.h>
+#include "game_core.h"
+#include "life_rule.h"
+#include "rule_circuit.h"
+
+#define ENSEMBLE_LANES 64
+
+// Many small independent toroidal boards advanced in lockstep. Boards are
+// stored interleaved: word (group, cell) holds that cell for 64 boards, one
+// board per bit, so the rule is evaluated for 64 boards per bitwise operation.
+typedef struct {
+    int cols;
+    int rows;
+    int n_boards;
+    int n_groups;
+    int generation;
+    int n_active;
+    LifeRule rule;
+    RuleCircuit circuit;  // rule compiled to bitsliced logic
+    uint64_t *regs;       // circuit registers, one row of words each
+    uint64_t *planes;     // per group: three rotating generations (prev, curr, next)
+    uint8_t *phase;       // per group: which of the three slots holds curr
+    uint64_t *active;     // per group: lanes still evolving
+    int *settled_at;      // per board: generation it was found stable, or -1
+    int *x_left, *x_right;
+    int *y_up, *y_down;
+} Ensemble;
+
+int ensemble_init(Ensemble *e, int cols, int rows, int n_boards);
+void ensemble_free(Ensemble *e);
+void ensemble_set_rule(Ensemble *e, const LifeRule *rule);
+void ensemble_set_board(Ensemble *e, int board, const CellState *grid);
+void ensemble_get_board(const Ensemble *e, int board, CellState *grid);
+int ensemble_step(Ensemble *e);
+int ensemble_run(Ensemble *e, int max_generations);
+int ensemble_board_active(const Ensemble *e, int board);
+
+#endif
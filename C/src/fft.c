@@ -0,0 +1,186 @@
+#include "fft.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct FftPlan {
+    int n;
+    int log2n;                 // radix-2 plans only
+    int *bitrev;
+    double complex *twiddles;  // n / 2 roots of unity
+    // Bluestein plans convolve with a chirp through a power-of-two plan
+    const FftPlan *inner;
+    double complex *chirp;
+    double complex *chirp_spectrum;
+    struct FftPlan *next;      // plan cache list
+};
+
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static FftPlan *cache = NULL;
+
+static int is_power_of_two(int n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+static void radix2(const FftPlan *plan, double complex *data) {
+    int n = plan->n;
+    for (int i = 0; i < n; i++) {
+        int j = plan->bitrev[i];
+        if (i < j) {
+            double complex t = data[i];
+            data[i] = data[j];
+            data[j] = t;
+        }
+    }
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len >> 1, step = n / len;
+        for (int start = 0; start < n; start += len) {
+            for (int k = 0; k < half; k++) {
+                double complex w = plan->twiddles[k * step];
+                double complex u = data[start + k];
+                double complex v = data[start + k + half] * w;
+                data[start + k] = u + v;
+                data[start + k + half] = u - v;
+            }
+        }
+    }
+}
+
+static void forward(const FftPlan *plan, double complex *data, double complex *scratch) {
+    if (!plan->inner) {
+        radix2(plan, data);
+        return;
+    }
+    int n = plan->n, m = plan->inner->n;
+    memset(scratch, 0, m * sizeof(double complex));
+    for (int k = 0; k < n; k++)
+        scratch[k] = data[k] * plan->chirp[k];
+    radix2(plan->inner, scratch);
+    for (int k = 0; k < m; k++)
+        scratch[k] = conj(scratch[k] * plan->chirp_spectrum[k]);
+    radix2(plan->inner, scratch);  // conj(FFT(conj(x))) is the unscaled inverse
+    for (int k = 0; k < n; k++)
+        data[k] = conj(scratch[k]) / m * plan->chirp[k];
+}
+
+// Unnormalized in both directions: a forward/inverse round trip scales by n.
+void fft_execute(const FftPlan *plan, double complex *data, int inverse, double complex *scratch) {
+    if (!inverse) {
+        forward(plan, data, scratch);
+        return;
+    }
+    for (int k = 0; k < plan->n; k++)
+        data[k] = conj(data[k]);
+    forward(plan, data, scratch);
+    for (int k = 0; k < plan->n; k++)
+        data[k] = conj(data[k]);
+}
+
+size_t fft_scratch_size(const FftPlan *plan) {
+    return plan->inner ? (size_t)plan->inner->n : 0;
+}
+
+static void free_plan(FftPlan *plan) {
+    free(plan->bitrev);
+    free(plan->twiddles);
+    free(plan->chirp);
+    free(plan->chirp_spectrum);
+    free(plan);
+}
+
+static FftPlan *build_radix2(int n) {
+    FftPlan *plan = calloc(1, sizeof(*plan));
+    if (!plan)
+        return NULL;
+    plan->n = n;
+    while ((1 << plan->log2n) < n)
+        plan->log2n++;
+    plan->bitrev = malloc(n * sizeof(int));
+    plan->twiddles = malloc((n / 2 + 1) * sizeof(double complex));
+    if (!plan->bitrev || !plan->twiddles) {
+        free_plan(plan);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        int r = 0;
+        for (int b = 0; b < plan->log2n; b++)
+            r |= ((i >> b) & 1) << (plan->log2n - 1 - b);
+        plan->bitrev[i] = r;
+    }
+    for (int k = 0; k <= n / 2; k++)
+        plan->twiddles[k] = cexp(-2.0 * I * M_PI * k / n);
+    return plan;
+}
+
+static const FftPlan *lookup(int n) {
+    for (FftPlan *p = cache; p; p = p->next) {
+        if (p->n == n)
+            return p;
+    }
+    return NULL;
+}
+
+// Called with cache_lock held.
+static const FftPlan *get_locked(int n) {
+    const FftPlan *found = lookup(n);
+    if (found)
+        return found;
+
+    FftPlan *plan;
+    if (is_power_of_two(n)) {
+        plan = build_radix2(n);
+    } else {
+        int m = 1;
+        while (m < 2 * n - 1)
+            m <<= 1;
+        const FftPlan *inner = get_locked(m);
+        plan = inner ? calloc(1, sizeof(*plan)) : NULL;
+        if (plan) {
+            plan->n = n;
+            plan->inner = inner;
+            plan->chirp = malloc(n * sizeof(double complex));
+            plan->chirp_spectrum = calloc(m, sizeof(double complex));
+        }
+        if (plan && (!plan->chirp || !plan->chirp_spectrum)) {
+            free_plan(plan);
+            plan = NULL;
+        }
+        if (plan) {
+            // k^2 mod 2n keeps the chirp phase exact for large k
+            for (int k = 0; k < n; k++) {
+                long long sq = (long long)k * k % (2LL * n);
+                plan->chirp[k] = cexp(-I * M_PI * (double)sq / n);
+            }
+            plan->chirp_spectrum[0] = conj(plan->chirp[0]);
+            for (int k = 1; k < n; k++)
+                plan->chirp_spectrum[k] = plan->chirp_spectrum[m - k] = conj(plan->chirp[k]);
+            radix2(inner, plan->chirp_spectrum);
+        }
+    }
+    if (!plan)
+        return NULL;
+    plan->next = cache;
+    cache = plan;
+    return plan;
+}
+
+const FftPlan *fft_plan_get(int n) {
+    if (n < 1)
+        return NULL;
+    pthread_mutex_lock(&cache_lock);
+    const FftPlan *plan = get_locked(n);
+    pthread_mutex_unlock(&cache_lock);
+    return plan;
+}
+
+// Frees every cached plan; no plan obtained earlier may be used afterwards.
+void fft_plans_clear(void) {
+    pthread_mutex_lock(&cache_lock);
+    while (cache) {
+        FftPlan *next = cache->next;
+        free_plan(cache);
+        cache = next;
+    }
+    pthread_mutex_unlock(&cache_lock);
+}
@@ -0,0 +1,16 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex.h>
+#include <stddef.h>
+
+// Complex FFT of any length: iterative radix-2 for powers of two, Bluestein's
+// algorithm otherwise. Plans are immutable once built and shared process-wide.
+typedef struct FftPlan FftPlan;
+
+const FftPlan *fft_plan_get(int n);
+size_t fft_scratch_size(const FftPlan *plan);
+void fft_execute(const FftPlan *plan, double complex *data, int inverse, double complex *scratch);
+void fft_plans_clear(void);
+
+#endif
@@ -3,6 +3,8 @@
 #include <time.h>
 #include <unistd.h>
 #include "game_core.h"
+#include "eca.h"
+#include "random_fill.h"
 
 #define ALIVE_CHAR '*'
 #define DEAD_CHAR '.'
@@ -20,18 +22,40 @@ void print_grid(CellState *grid) {
     }
 }
 
-int main(void) {
-    srand(time(NULL));
+// Elementary CA (e.g. W30): a space-time diagram scrolling up the screen.
+static int run_elementary(uint8_t eca_rule) {
+    Eca eca;
+    if (eca_init(&eca, GRID_COLS, eca_rule) != 0)
+        return 1;
+    eca_seed_center(&eca);
+
+    CellState grid[GRID_SIZE];
+    eca_diagram(&eca, grid, GRID_COLS, GRID_ROWS);
+    for (;;) {
+        print_grid(grid);
+        usleep(REFRESH_RATE_IN_MS * 1000);
+        eca_scroll(&eca, grid, GRID_COLS, GRID_ROWS);
+    }
+}
+
+int main(int argc, char **argv) {
+    LifeRule rule = LIFE_RULE_CONWAY;
+    uint8_t eca_rule;
+    if (argc > 1 && (argv[1][0] == 'W' || argv[1][0] == 'w') && eca_rule_parse(&eca_rule, argv[1]) == 0)
+        return run_elementary(eca_rule);
+    if (argc > 1 && life_rule_parse(&rule, argv[1]) != 0) {
+        fprintf(stderr, "Invalid rulestring '%s' (expected e.g. B3/S23 or W30)\n", argv[1]);
+        return 1;
+    }
 
     CellState old_grid[GRID_SIZE], new_grid[GRID_SIZE];
-    fill_grid(old_grid, DEAD);
-    randomize_grid(old_grid, 2);  // 50% density
+    randomize_grid_seeded(old_grid, 0.5, (uint64_t)time(NULL));
 
     for (;;) {
-        compute_new_generation(old_grid, new_grid);
+        compute_new_generation_rule(old_grid, new_grid, &rule);
         print_grid(new_grid);
         usleep(REFRESH_RATE_IN_MS * 1000);
-        compute_new_generation(new_grid, old_grid);
+        compute_new_generation_rule(new_grid, old_grid, &rule);
         print_grid(old_grid);
         usleep(REFRESH_RATE_IN_MS * 1000);
     }
@@ -1,10 +1,16 @@
 #include "game_core.h"
+#include "grid_hash.h"
+#include "region.h"
 #include <stdlib.h>
 
+int wrap_index(int x, int y, int cols, int rows) {
+    x = (x % cols + cols) % cols;
+    y = (y % rows + rows) % rows;
+    return y * cols + x;
+}
+
 int pos_to_index(int x, int y) {
-    x = (x % GRID_COLS + GRID_COLS) % GRID_COLS;
-    y = (y % GRID_ROWS + GRID_ROWS) % GRID_ROWS;
-    return y * GRID_COLS + x;
+    return wrap_index(x, y, GRID_COLS, GRID_ROWS);
 }
 
 void set_cell(CellState *grid, int x, int y, CellState state) {
@@ -16,11 +22,7 @@ CellState get_cell(const CellState *grid, int x, int y) {
 }
 
 void fill_grid(CellState *grid, CellState state) {
-    for (int y = 0; y < GRID_ROWS; y++) {
-        for (int x = 0; x < GRID_COLS; x++) {
-            set_cell(grid, x, y, state);
-        }
-    }
+    region_fill(grid, GRID_COLS, GRID_ROWS, 0, 0, GRID_COLS, GRID_ROWS, state);
 }
 
 int get_alive_neighbors(const CellState *grid, int x, int y) {
@@ -28,7 +30,7 @@ int get_alive_neighbors(const CellState *grid, int x, int y) {
     for (int y_off = -1; y_off <= 1; y_off++) {
         for (int x_off = -1; x_off <= 1; x_off++) {
             if (x_off || y_off) {
-                n_alive += get_cell(grid, x + x_off, y + y_off) == ALIVE ? 1 : 0;
+                n_alive += get_cell(grid, x + x_off, y + y_off) != DEAD ? 1 : 0;
             }
         }
     }
@@ -36,18 +38,87 @@ int get_alive_neighbors(const CellState *grid, int x, int y) {
 }
 
 void compute_new_generation(const CellState *curr_grid, CellState *next_grid) {
-    for (int y = 0; y < GRID_ROWS; y++) {
-        for (int x = 0; x < GRID_COLS; x++) {
-            CellState curr_state = get_cell(curr_grid, x, y);
-            CellState new_state = DEAD;
-            int alive_count = get_alive_neighbors(curr_grid, x, y);
-            if (alive_count == 3)
-                new_state = ALIVE;
-            if (curr_state == ALIVE && alive_count == 2)
-                new_state = ALIVE;
-            set_cell(next_grid, x, y, new_state);
+    compute_new_generation_rule(curr_grid, next_grid, &LIFE_RULE_CONWAY);
+}
+
+static void emit_run(ChangeRing *events, ChangeRun *run) {
+    if (run->length > 0)
+        change_ring_push(events, run);  // a full ring counts the drop itself
+    run->length = 0;
+}
+
+// Wrapping is resolved once per row and column instead of per neighbor, and
+// the rule is a table lookup on (state, alive_count), so any B/S rule runs
+// the same branch-free loop. Any nonzero state reads as alive (see same_cell)
+// and the row is written as DEAD/ALIVE. Writes row y of next_grid and returns
+// nonzero if any of its cells changed; every generation pass uses it. With
+// events, changed cells are also pushed as runs from inside the same loop;
+// callers pass a constant NULL otherwise, so the inlined loop stays plain.
+static inline int step_row(const CellState *curr_grid, CellState *next_grid, const LifeRule *rule, int y,
+                           ChangeRing *events, uint32_t generation) {
+    const CellState *up = curr_grid + pos_to_index(0, y - 1);
+    const CellState *mid = curr_grid + pos_to_index(0, y);
+    const CellState *down = curr_grid + pos_to_index(0, y + 1);
+    CellState *out = next_grid + pos_to_index(0, y);
+    ChangeRun run = {generation, 0, (uint16_t)y, 0, CHANGE_BIRTH};
+    int changed = 0;
+    for (int x = 0; x < GRID_COLS; x++) {
+        int xl = x == 0 ? GRID_COLS - 1 : x - 1;
+        int xr = x == GRID_COLS - 1 ? 0 : x + 1;
+        int alive_count = (up[xl] != DEAD) + (up[x] != DEAD) + (up[xr] != DEAD) + (mid[xl] != DEAD) +
+                          (mid[xr] != DEAD) + (down[xl] != DEAD) + (down[x] != DEAD) + (down[xr] != DEAD);
+        int alive = mid[x] != DEAD;
+        out[x] = (CellState)rule->table[LIFE_RULE_INDEX(alive, alive_count)];
+        int flipped = (out[x] != DEAD) != alive;
+        changed |= flipped;
+        if (events && flipped) {
+            uint8_t kind = alive ? CHANGE_DEATH : CHANGE_BIRTH;
+            if (run.length > 0 && (run.kind != kind || run.x + run.length != x))
+                emit_run(events, &run);
+            if (run.length == 0) {
+                run.x = (uint16_t)x;
+                run.kind = kind;
+            }
+            run.length++;
         }
     }
+    if (events)
+        emit_run(events, &run);
+    return changed;
+}
+
+void compute_new_generation_rule(const CellState *curr_grid, CellState *next_grid, const LifeRule *rule) {
+    for (int y = 0; y < GRID_ROWS; y++)
+        step_row(curr_grid, next_grid, rule, y, NULL, 0);
+}
+
+// Same pass as compute_new_generation_rule, additionally pushing the cells
+// that changed as runs of births or deaths per row, then an end-of-generation
+// record. generation is the number of the generation being written.
+void compute_new_generation_events(const CellState *curr_grid, CellState *next_grid, const LifeRule *rule,
+                                   ChangeRing *events, uint32_t generation) {
+    uint64_t dropped = change_ring_dropped(events);
+    for (int y = 0; y < GRID_ROWS; y++)
+        step_row(curr_grid, next_grid, rule, y, events, generation);
+    dropped = change_ring_dropped(events) - dropped;
+    ChangeRun end = {generation, 0, 0, (uint16_t)(dropped > UINT16_MAX ? UINT16_MAX : dropped),
+                     CHANGE_END_OF_GENERATION};
+    change_ring_push(events, &end);
+}
+
+// Same pass as compute_new_generation_rule. A row is rehashed right after it
+// is written, while still in cache, and only if some cell in it changed.
+// hashes must describe curr_grid on entry and describes next_grid on return;
+// returns -1 without stepping if it is not sized GRID_COLS x GRID_ROWS.
+int compute_new_generation_hashed(const CellState *curr_grid, CellState *next_grid, const LifeRule *rule,
+                                  RowHashes *hashes) {
+    if (hashes->cols != GRID_COLS || hashes->rows != GRID_ROWS)
+        return -1;
+    for (int y = 0; y < GRID_ROWS; y++) {
+        if (step_row(curr_grid, next_grid, rule, y, NULL, 0))
+            row_hashes_set(hashes, y, grid_row_hash(next_grid + pos_to_index(0, y), GRID_COLS));
+    }
+    return 0;
 }
 
 void randomize_grid(CellState *grid, int density_inverse) {
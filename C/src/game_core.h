@@ -1,18 +1,36 @@
 #ifndef GAME_CORE_H
 #define GAME_CORE_H
 
+#include <stdint.h>
+#include "change_ring.h"
+#include "life_rule.h"
+
 #define GRID_COLS 120
 #define GRID_ROWS 120
 #define GRID_SIZE (GRID_COLS * GRID_ROWS)
 
 typedef enum { DEAD = 0, ALIVE = 1 } CellState;
 
+// Any nonzero state counts as alive, so two cells are the same when both are
+// dead or both are alive; hashing, comparison and change tracking agree.
+static inline int same_cell(CellState a, CellState b) {
+    return (a != DEAD) == (b != DEAD);
+}
+
+typedef struct RowHashes RowHashes;  // grid_hash.h
+
+int wrap_index(int x, int y, int cols, int rows);
 int pos_to_index(int x, int y);
 void set_cell(CellState *grid, int x, int y, CellState state);
 CellState get_cell(const CellState *grid, int x, int y);
 void fill_grid(CellState *grid, CellState state);
 int get_alive_neighbors(const CellState *grid, int x, int y);
 void compute_new_generation(const CellState *curr_grid, CellState *next_grid);
+void compute_new_generation_rule(const CellState *curr_grid, CellState *next_grid, const LifeRule *rule);
+void compute_new_generation_events(const CellState *curr_grid, CellState *next_grid, const LifeRule *rule,
+                                   ChangeRing *events, uint32_t generation);
+int compute_new_generation_hashed(const CellState *curr_grid, CellState *next_grid, const LifeRule *rule,
+                                  RowHashes *hashes);
 void randomize_grid(CellState *grid, int density_inverse);
 
 #endif
@@ -1,7 +1,10 @@
+#include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include "raylib.h"
 #include "game_core.h"
+#include "eca.h"
+#include "random_fill.h"
 
 #define CELL_SIZE 6
 #define WINDOW_WIDTH (GRID_COLS * CELL_SIZE)
@@ -25,15 +28,37 @@ void draw_grid(const CellState *grid) {
     }
 }
 
-int main(void) {
-    srand(time(NULL));
+int main(int argc, char **argv) {
+    LifeRule rule = LIFE_RULE_CONWAY;
+    uint8_t eca_rule;
+    int elementary = argc > 1 && (argv[1][0] == 'W' || argv[1][0] == 'w') &&
+                     eca_rule_parse(&eca_rule, argv[1]) == 0;
+    if (argc > 1 && !elementary && life_rule_parse(&rule, argv[1]) != 0) {
+        fprintf(stderr, "Invalid rulestring '%s' (expected e.g. B3/S23 or W30)\n", argv[1]);
+        return 1;
+    }
+    char rule_name[32];
+    life_rule_format(&rule, rule_name, sizeof(rule_name));
+
+    // Elementary CA: the grid shows a space-time diagram scrolling upwards
+    Eca eca;
+    if (elementary) {
+        if (eca_init(&eca, GRID_COLS, eca_rule) != 0)
+            return 1;
+        snprintf(rule_name, sizeof(rule_name), "W%d", eca_rule);
+    }
+
+    uint64_t seed = (uint64_t)time(NULL);
 
     CellState grid1[GRID_SIZE], grid2[GRID_SIZE];
     CellState *current_grid = grid1;
     CellState *next_grid = grid2;
 
-    fill_grid(current_grid, DEAD);
-    randomize_grid(current_grid, 4);  // 25% density
+    randomize_grid_seeded(current_grid, 0.25, seed);
+    if (elementary) {
+        eca_seed_center(&eca);
+        eca_diagram(&eca, current_grid, GRID_COLS, GRID_ROWS);
+    }
 
     InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Conway's Game of Life");
     SetTargetFPS(TARGET_FPS);
@@ -47,12 +72,19 @@ int main(void) {
             paused = !paused;
         }
         if (IsKeyPressed(KEY_R)) {
-            fill_grid(current_grid, DEAD);
-            randomize_grid(current_grid, 4);
+            randomize_grid_seeded(current_grid, 0.25, ++seed);
+            if (elementary) {
+                eca_randomize(&eca, 0.5, seed);
+                eca_diagram(&eca, current_grid, GRID_COLS, GRID_ROWS);
+            }
             generation = 0;
         }
         if (IsKeyPressed(KEY_C)) {
             fill_grid(current_grid, DEAD);
+            if (elementary) {
+                eca_seed_center(&eca);
+                eca_diagram(&eca, current_grid, GRID_COLS, GRID_ROWS);
+            }
             generation = 0;
         }
 
@@ -69,8 +101,11 @@ int main(void) {
         }
 
         // Update simulation
-        if (!paused) {
-            compute_new_generation(current_grid, next_grid);
+        if (!paused && elementary) {
+            eca_scroll(&eca, current_grid, GRID_COLS, GRID_ROWS);
+            generation++;
+        } else if (!paused) {
+            compute_new_generation_rule(current_grid, next_grid, &rule);
             CellState *temp = current_grid;
             current_grid = next_grid;
             next_grid = temp;
@@ -86,11 +121,14 @@ int main(void) {
         // Draw UI overlay
         DrawText(TextFormat("Generation: %d", generation), 10, 10, 20, WHITE);
         DrawText(paused ? "PAUSED" : "RUNNING", 10, 35, 20, paused ? YELLOW : GREEN);
+        DrawText(rule_name, 10, 60, 20, WHITE);
         DrawText("SPACE: Pause | R: Randomize | C: Clear | Mouse: Draw", 10, WINDOW_HEIGHT - 25, 16, GRAY);
 
         EndDrawing();
     }
 
     CloseWindow();
+    if (elementary)
+        eca_free(&eca);
     return 0;
 }
@@ -0,0 +1,254 @@
+#include "gameoflife.h"
+#include "bitgrid.h"
+#include "jit_kernel.h"
+#include "life_rule.h"
+#include "neighbor_count.h"
+#include "rule_circuit.h"
+#include <stdlib.h>
+#include <string.h>
+
+// The live state is kept in the current engine's representation: `bits`
+// for the bit-packed engine, `cells` otherwise. Switching engines converts.
+struct GolUniverse {
+    int cols;
+    int rows;
+    uint64_t generation;
+    GolEngine engine;
+    LifeRule rule;
+    RuleCircuit circuit;
+    CellState *cells, *next;
+    uint8_t *counts;          // one row of neighbor counts (scalar engine)
+    BitGrid bits, bits_next;
+    uint64_t *scratch;        // circuit registers (bit-packed engine)
+    JitKernel jit;
+    int jit_ready;
+};
+
+uint32_t gol_version(void) {
+    return ((uint32_t)GOL_VERSION_MAJOR << 16) | GOL_VERSION_MINOR;
+}
+
+const char *gol_status_string(GolStatus status) {
+    switch (status) {
+    case GOL_OK: return "ok";
+    case GOL_ERR_INVALID: return "invalid argument";
+    case GOL_ERR_NOMEM: return "out of memory";
+    }
+    return "unknown status";
+}
+
+const char *gol_engine_name(GolEngine engine) {
+    switch (engine) {
+    case GOL_ENGINE_AUTO: return "auto";
+    case GOL_ENGINE_SCALAR: return "scalar";
+    case GOL_ENGINE_BITGRID: return "bitgrid";
+    case GOL_ENGINE_JIT: return "jit";
+    }
+    return "unknown";
+}
+
+static size_t n_cells(const GolUniverse *u) {
+    return (size_t)u->cols * u->rows;
+}
+
+// Brings `cells` up to date when the bit-packed engine holds the state.
+static void sync_cells(const GolUniverse *u) {
+    if (u->engine == GOL_ENGINE_BITGRID)
+        bitgrid_store(&u->bits, u->cells);
+}
+
+static void stop_jit(GolUniverse *u) {
+    if (u->jit_ready)
+        jit_kernel_free(&u->jit);
+    u->jit_ready = 0;
+}
+
+static GolStatus start_jit(GolUniverse *u) {
+    KernelParams params = {u->rule, u->cols, u->rows, u->cols, BOUNDARY_TORUS};
+    stop_jit(u);
+    // Falls back to a generic kernel when no compiler is available.
+    if (jit_kernel_init(&u->jit, &params, NULL) != 0)
+        return GOL_ERR_INVALID;
+    u->jit_ready = 1;
+    return GOL_OK;
+}
+
+GolStatus gol_create(GolUniverse **out, int cols, int rows, const char *rulestring, GolEngine engine) {
+    if (!out || cols < 1 || rows < 1)
+        return GOL_ERR_INVALID;
+    *out = NULL;
+    GolUniverse *u = calloc(1, sizeof(*u));
+    if (!u)
+        return GOL_ERR_NOMEM;
+    u->cols = cols;
+    u->rows = rows;
+    u->engine = GOL_ENGINE_SCALAR;
+    u->rule = LIFE_RULE_CONWAY;
+    if (rulestring && life_rule_parse(&u->rule, rulestring) != 0) {
+        free(u);
+        return GOL_ERR_INVALID;
+    }
+    rule_circuit_compile(&u->circuit, &u->rule);
+
+    u->cells = calloc(n_cells(u), sizeof(CellState));
+    u->next = calloc(n_cells(u), sizeof(CellState));
+    u->counts = malloc(cols);
+    int bits_ok = bitgrid_init(&u->bits, cols, rows) == 0 && bitgrid_init(&u->bits_next, cols, rows) == 0;
+    u->scratch = bits_ok ? malloc(bitgrid_scratch_words(&u->bits) * sizeof(uint64_t)) : NULL;
+    if (!u->cells || !u->next || !u->counts || !u->scratch) {
+        gol_destroy(u);
+        return GOL_ERR_NOMEM;
+    }
+
+    GolStatus status = gol_set_engine(u, engine);
+    if (status != GOL_OK) {
+        gol_destroy(u);
+        return status;
+    }
+    *out = u;
+    return GOL_OK;
+}
+
+void gol_destroy(GolUniverse *u) {
+    if (!u)
+        return;
+    stop_jit(u);
+    free(u->cells);
+    free(u->next);
+    free(u->counts);
+    free(u->scratch);
+    bitgrid_free(&u->bits);
+    bitgrid_free(&u->bits_next);
+    free(u);
+}
+
+GolStatus gol_set_engine(GolUniverse *u, GolEngine engine) {
+    if (!u || engine < GOL_ENGINE_AUTO || engine > GOL_ENGINE_JIT)
+        return GOL_ERR_INVALID;
+    if (engine == GOL_ENGINE_AUTO)
+        engine = GOL_ENGINE_BITGRID;
+    sync_cells(u);
+    if (engine == GOL_ENGINE_JIT && !u->jit_ready) {
+        GolStatus status = start_jit(u);
+        if (status != GOL_OK)
+            return status;
+    }
+    // The kernel is only kept while JIT is active, so rule changes on other
+    // engines never invoke the compiler; switching back recompiles.
+    if (engine != GOL_ENGINE_JIT)
+        stop_jit(u);
+    if (engine == GOL_ENGINE_BITGRID)
+        bitgrid_load(&u->bits, u->cells);
+    u->engine = engine;
+    return GOL_OK;
+}
+
+GolStatus gol_set_rule(GolUniverse *u, const char *rulestring) {
+    LifeRule rule;
+    if (!u || !rulestring || life_rule_parse(&rule, rulestring) != 0)
+        return GOL_ERR_INVALID;
+    u->rule = rule;
+    rule_circuit_compile(&u->circuit, &u->rule);
+    if (u->engine != GOL_ENGINE_JIT)
+        return GOL_OK;
+    GolStatus status = start_jit(u);
+    if (status != GOL_OK)
+        u->engine = GOL_ENGINE_SCALAR;  // never step with a freed kernel
+    return status;
+}
+
+static void step_scalar(GolUniverse *u) {
+    for (int y = 0; y < u->rows; y++) {
+        const CellState *row = u->cells + (size_t)y * u->cols;
+        CellState *out = u->next + (size_t)y * u->cols;
+        neighbor_count_row(u->cells, u->cols, u->rows, y, u->counts);
+        for (int x = 0; x < u->cols; x++)
+            out[x] = (CellState)u->rule.table[LIFE_RULE_INDEX(row[x], u->counts[x])];
+    }
+}
+
+GolStatus gol_step(GolUniverse *u, uint64_t generations) {
+    if (!u)
+        return GOL_ERR_INVALID;
+    for (uint64_t g = 0; g < generations; g++) {
+        if (u->engine == GOL_ENGINE_BITGRID) {
+            bitgrid_step(&u->bits, &u->bits_next, &u->circuit, u->scratch);
+            BitGrid temp = u->bits;
+            u->bits = u->bits_next;
+            u->bits_next = temp;
+        } else {
+            if (u->engine == GOL_ENGINE_JIT)
+                jit_kernel_step(&u->jit, u->cells, u->next);
+            else
+                step_scalar(u);
+            CellState *temp = u->cells;
+            u->cells = u->next;
+            u->next = temp;
+        }
+        u->generation++;
+    }
+    return GOL_OK;
+}
+
+GolStatus gol_import(GolUniverse *u, const uint8_t *cells, size_t count) {
+    if (!u || !cells || count != n_cells(u))
+        return GOL_ERR_INVALID;
+    for (size_t i = 0; i < count; i++)
+        u->cells[i] = cells[i] ? ALIVE : DEAD;
+    if (u->engine == GOL_ENGINE_BITGRID)
+        bitgrid_load(&u->bits, u->cells);
+    u->generation = 0;
+    return GOL_OK;
+}
+
+GolStatus gol_export(const GolUniverse *u, uint8_t *cells, size_t count) {
+    if (!u || !cells || count != n_cells(u))
+        return GOL_ERR_INVALID;
+    sync_cells(u);
+    for (size_t i = 0; i < count; i++)
+        cells[i] = u->cells[i] == ALIVE;
+    return GOL_OK;
+}
+
+// Coordinates wrap like pos_to_index.
+GolStatus gol_set_cell(GolUniverse *u, int x, int y, int alive) {
+    if (!u)
+        return GOL_ERR_INVALID;
+    CellState state = alive ? ALIVE : DEAD;
+    if (u->engine == GOL_ENGINE_BITGRID)
+        bitgrid_set(&u->bits, x, y, state);
+    else
+        u->cells[wrap_index(x, y, u->cols, u->rows)] = state;
+    return GOL_OK;
+}
+
+int gol_get_cell(const GolUniverse *u, int x, int y) {
+    if (!u)
+        return 0;
+    if (u->engine == GOL_ENGINE_BITGRID)
+        return bitgrid_get(&u->bits, x, y) == ALIVE;
+    return u->cells[wrap_index(x, y, u->cols, u->rows)] == ALIVE;
+}
+
+GolStatus gol_get_stats(const GolUniverse *u, GolStats *stats) {
+    if (!u || !stats || stats->struct_size < offsetof(GolStats, cols))
+        return GOL_ERR_INVALID;
+    GolStats full;
+    memset(&full, 0, sizeof(full));
+    full.struct_size = stats->struct_size < sizeof(full) ? stats->struct_size : sizeof(full);
+    full.cols = u->cols;
+    full.rows = u->rows;
+    full.generation = u->generation;
+    full.engine = u->engine;
+    life_rule_format(&u->rule, full.rule, sizeof(full.rule));
+    if (u->engine == GOL_ENGINE_BITGRID) {
+        size_t words = (size_t)u->bits.words_per_row * u->rows;
+        for (size_t i = 0; i < words; i++)
+            full.population += (uint64_t)__builtin_popcountll(u->bits.words[i]);
+    } else {
+        for (size_t i = 0; i < n_cells(u); i++)
+            full.population += u->cells[i] == ALIVE;
+    }
+    memcpy(stats, &full, full.struct_size);
+    return GOL_OK;
+}
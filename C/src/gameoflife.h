@@ -0,0 +1,76 @@
+#ifndef GAMEOFLIFE_H
+#define GAMEOFLIFE_H
+
+// Public API of libgameoflife. Everything else in src/ is internal to the
+// library; only the symbols declared here are exported.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bumped on incompatible changes (also the shared object's soname) ...
+#define GOL_VERSION_MAJOR 1
+// ... and on backwards-compatible additions.
+#define GOL_VERSION_MINOR 0
+
+#if defined(GOL_BUILD_LIBRARY) && defined(__GNUC__)
+#define GOL_API __attribute__((visibility("default")))
+#else
+#define GOL_API
+#endif
+
+typedef struct GolUniverse GolUniverse;
+
+typedef enum {
+    GOL_OK = 0,
+    GOL_ERR_INVALID = -1,   // bad argument, size or rulestring
+    GOL_ERR_NOMEM = -2
+} GolStatus;
+
+typedef enum {
+    GOL_ENGINE_AUTO = 0,    // library's choice; currently the bit-packed engine
+    GOL_ENGINE_SCALAR = 1,  // one byte per cell, batched neighbor counts
+    GOL_ENGINE_BITGRID = 2, // 64 cells per word, rule compiled to boolean logic
+    GOL_ENGINE_JIT = 3      // kernel compiled at runtime for this size and rule
+} GolEngine;
+
+// Callers set struct_size to sizeof(GolStats); the library fills only the
+// fields that fit, so the struct can grow without breaking older callers.
+typedef struct {
+    size_t struct_size;
+    int cols;
+    int rows;
+    uint64_t generation;
+    uint64_t population;
+    GolEngine engine;
+    char rule[32];
+} GolStats;
+
+// (GOL_VERSION_MAJOR << 16) | GOL_VERSION_MINOR of the loaded library.
+GOL_API uint32_t gol_version(void);
+GOL_API const char *gol_status_string(GolStatus status);
+GOL_API const char *gol_engine_name(GolEngine engine);
+
+// The universe is a cols x rows torus; rulestring is B/S notation or NULL
+// for Conway's rule.
+GOL_API GolStatus gol_create(GolUniverse **out, int cols, int rows, const char *rulestring, GolEngine engine);
+GOL_API void gol_destroy(GolUniverse *universe);
+GOL_API GolStatus gol_set_engine(GolUniverse *universe, GolEngine engine);
+GOL_API GolStatus gol_set_rule(GolUniverse *universe, const char *rulestring);
+GOL_API GolStatus gol_step(GolUniverse *universe, uint64_t generations);
+
+// Cells are one byte each, row-major, nonzero meaning alive.
+GOL_API GolStatus gol_import(GolUniverse *universe, const uint8_t *cells, size_t n_cells);
+GOL_API GolStatus gol_export(const GolUniverse *universe, uint8_t *cells, size_t n_cells);
+GOL_API GolStatus gol_set_cell(GolUniverse *universe, int x, int y, int alive);
+GOL_API int gol_get_cell(const GolUniverse *universe, int x, int y);
+GOL_API GolStatus gol_get_stats(const GolUniverse *universe, GolStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+#include "generations.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "life_rule.h"
+
+static const char *parse_states(const char *s, int *n_states) {
+    char *end;
+    long n = strtol(s, &end, 10);
+    if (end == s || n < 2 || n > GENERATIONS_MAX_STATES)
+        return NULL;
+    *n_states = (int)n;
+    return end;
+}
+
+// Accepts "B2/S/C3" (C or G for the state count, any order and case) and
+// the survive/birth/states form "/2/3" or "345/2/4".
+int generations_rule_parse(GenerationsRule *rule, const char *rulestring) {
+    const char *s = rulestring;
+    int seen_birth = 0, seen_survive = 0, seen_states = 0;
+    rule->birth = rule->survive = 0;
+    rule->n_states = 2;
+
+    if (isdigit((unsigned char)*s) || *s == '/') {
+        s = life_rule_parse_counts(s, &rule->survive);
+        if (*s++ != '/')
+            return -1;
+        s = life_rule_parse_counts(s, &rule->birth);
+        if (*s++ != '/')
+            return -1;
+        s = parse_states(s, &rule->n_states);
+        return s && *s == '\0' ? 0 : -1;
+    }
+
+    while (*s) {
+        char c = (char)toupper((unsigned char)*s++);
+        if (c == 'B' && !seen_birth) {
+            s = life_rule_parse_counts(s, &rule->birth);
+            seen_birth = 1;
+        } else if (c == 'S' && !seen_survive) {
+            s = life_rule_parse_counts(s, &rule->survive);
+            seen_survive = 1;
+        } else if ((c == 'C' || c == 'G') && !seen_states) {
+            s = parse_states(s, &rule->n_states);
+            seen_states = 1;
+            if (!s)
+                return -1;
+        } else {
+            return -1;
+        }
+        if (*s == '/' && *++s == '\0')
+            return -1;
+    }
+    return seen_birth && seen_survive ? 0 : -1;
+}
+
+void generations_rule_format(const GenerationsRule *rule, char *buf, size_t len) {
+    char digits[2][10];
+    uint16_t masks[2] = {rule->birth, rule->survive};
+    for (int i = 0; i < 2; i++) {
+        int k = 0;
+        for (int n = 0; n <= 8; n++) {
+            if ((masks[i] >> n) & 1)
+                digits[i][k++] = (char)('0' + n);
+        }
+        digits[i][k] = '\0';
+    }
+    snprintf(buf, len, "B%s/S%s/C%d", digits[0], digits[1], rule->n_states);
+}
+
+static inline uint8_t next_state(uint8_t state, int alive_count, uint16_t birth, uint16_t survive, uint8_t wrap) {
+    // Alive cells that do not survive and dying cells both advance one state;
+    // uint8_t overflow makes 256-state rules wrap to dead on their own.
+    uint8_t advanced = (uint8_t)(state + 1);
+    advanced = advanced == wrap ? 0 : advanced;
+    uint8_t born = (birth >> alive_count) & 1;
+    uint8_t stays = (survive >> alive_count) & 1;
+    uint8_t result = state == GEN_ALIVE && stays ? GEN_ALIVE : advanced;
+    return state == GEN_DEAD ? born : result;
+}
+
+// Only state 1 counts as a neighbor. The interior loop has no wrapping and
+// no data-dependent branches, so the compiler can vectorize it.
+void generations_step(const uint8_t *curr_grid, uint8_t *next_grid, int cols, int rows, const GenerationsRule *rule) {
+    uint16_t birth = rule->birth, survive = rule->survive;
+    uint8_t wrap = (uint8_t)rule->n_states;
+
+    for (int y = 0; y < rows; y++) {
+        const uint8_t *up = curr_grid + (size_t)(y == 0 ? rows - 1 : y - 1) * cols;
+        const uint8_t *mid = curr_grid + (size_t)y * cols;
+        const uint8_t *down = curr_grid + (size_t)(y == rows - 1 ? 0 : y + 1) * cols;
+        uint8_t *out = next_grid + (size_t)y * cols;
+
+        for (int x = 1; x < cols - 1; x++) {
+            int n = (up[x - 1] == GEN_ALIVE) + (up[x] == GEN_ALIVE) + (up[x + 1] == GEN_ALIVE) +
+                    (mid[x - 1] == GEN_ALIVE) + (mid[x + 1] == GEN_ALIVE) +
+                    (down[x - 1] == GEN_ALIVE) + (down[x] == GEN_ALIVE) + (down[x + 1] == GEN_ALIVE);
+            out[x] = next_state(mid[x], n, birth, survive, wrap);
+        }
+
+        int edges[2] = {0, cols - 1};
+        for (int i = 0; i < (cols > 1 ? 2 : 1); i++) {
+            int x = edges[i];
+            int xl = x == 0 ? cols - 1 : x - 1;
+            int xr = x == cols - 1 ? 0 : x + 1;
+            int n = (up[xl] == GEN_ALIVE) + (up[x] == GEN_ALIVE) + (up[xr] == GEN_ALIVE) +
+                    (mid[xl] == GEN_ALIVE) + (mid[xr] == GEN_ALIVE) +
+                    (down[xl] == GEN_ALIVE) + (down[x] == GEN_ALIVE) + (down[xr] == GEN_ALIVE);
+            out[x] = next_state(mid[x], n, birth, survive, wrap);
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef GENERATIONS_H
+#define GENERATIONS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define GENERATIONS_MAX_STATES 256
+
+// Cell states for Generations rules, one byte per cell: 0 is dead, 1 is
+// alive, 2..n_states-1 are dying and count as dead for neighbors.
+enum { GEN_DEAD = 0, GEN_ALIVE = 1 };
+
+typedef struct {
+    uint16_t birth;    // bit n set: a dead cell with n alive neighbors is born
+    uint16_t survive;  // bit n set: an alive cell with n alive neighbors stays alive
+    int n_states;      // 2..256; 2 is an ordinary B/S rule
+} GenerationsRule;
+
+int generations_rule_parse(GenerationsRule *rule, const char *rulestring);
+void generations_rule_format(const GenerationsRule *rule, char *buf, size_t len);
+void generations_step(const uint8_t *curr_grid, uint8_t *next_grid, int cols, int rows, const GenerationsRule *rule);
+
+#endif
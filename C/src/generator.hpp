@@ -0,0 +1,101 @@
+#ifndef GOL_GENERATOR_HPP
+#define GOL_GENERATOR_HPP
+
+// Minimal synchronous generator for C++20 coroutines, standing in for
+// std::generator (C++23). Yielded values are referenced, never copied: the
+// coroutine stays suspended at co_yield while the consumer uses the value.
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace gol {
+
+template <class T>
+class Generator {
+public:
+    using reference = T &;
+
+    struct promise_type {
+        T *value = nullptr;
+        std::exception_ptr error;
+
+        Generator get_return_object() { return Generator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T &v) noexcept {
+            value = std::addressof(v);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(handle_type h) : h_(h) {}
+
+        reference operator*() const { return *h_.promise().value; }
+        T *operator->() const { return h_.promise().value; }
+        iterator &operator++() {
+            resume(h_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !h_ || h_.done(); }
+
+    private:
+        handle_type h_;
+    };
+
+    Generator() = default;
+    Generator(Generator &&other) noexcept : h_(std::exchange(other.h_, {})) {}
+    Generator &operator=(Generator &&other) noexcept {
+        if (this != &other) {
+            if (h_)
+                h_.destroy();
+            h_ = std::exchange(other.h_, {});
+        }
+        return *this;
+    }
+    Generator(const Generator &) = delete;
+    Generator &operator=(const Generator &) = delete;
+    ~Generator() {
+        if (h_)
+            h_.destroy();
+    }
+
+    // Runs the coroutine to its first co_yield; call once.
+    iterator begin() {
+        if (h_)
+            resume(h_);
+        return iterator(h_);
+    }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit Generator(handle_type h) : h_(h) {}
+
+    static void resume(handle_type h) {
+        h.resume();
+        if (h.done() && h.promise().error)
+            std::rethrow_exception(h.promise().error);
+    }
+
+    handle_type h_;
+};
+
+}  // namespace gol
+
+#endif
@@ -0,0 +1,106 @@
+#include "grid_alloc.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+static size_t round_up(size_t n, size_t multiple) {
+    return (n + multiple - 1) / multiple * multiple;
+}
+
+static void *alloc_hugetlb(size_t bytes) {
+#ifdef MAP_HUGETLB
+    void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    return p == MAP_FAILED ? NULL : p;
+#else
+    (void)bytes;
+    return NULL;
+#endif
+}
+
+static void *alloc_thp(size_t bytes) {
+#ifdef MADV_HUGEPAGE
+    // Over-map by one huge page so the buffer can start on a 2 MiB boundary,
+    // otherwise the kernel can only back its interior with huge pages.
+    size_t span = bytes + HUGE_PAGE_SIZE;
+    uint8_t *raw = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+        return NULL;
+
+    uint8_t *base = (uint8_t *)round_up((uintptr_t)raw, HUGE_PAGE_SIZE);
+    size_t head = (size_t)(base - raw);
+    size_t tail = span - head - bytes;
+    if (head)
+        munmap(raw, head);
+    if (tail)
+        munmap(base + bytes, tail);
+
+    if (madvise(base, bytes, MADV_HUGEPAGE) != 0) {
+        munmap(base, bytes);
+        return NULL;
+    }
+    return base;
+#else
+    (void)bytes;
+    return NULL;
+#endif
+}
+
+int grid_buffer_alloc(GridBuffer *buf, size_t n_cells, GridBacking preferred) {
+    size_t payload = n_cells * sizeof(CellState);
+    memset(buf, 0, sizeof(*buf));
+    if (n_cells == 0 || payload / sizeof(CellState) != n_cells)
+        return -1;
+
+    if (preferred <= GRID_BACKING_HUGETLB) {
+        size_t bytes = round_up(payload, HUGE_PAGE_SIZE);
+        void *p = alloc_hugetlb(bytes);
+        if (p) {
+            *buf = (GridBuffer){p, n_cells, bytes, GRID_BACKING_HUGETLB};
+            return 0;
+        }
+    }
+
+    if (preferred <= GRID_BACKING_THP) {
+        size_t bytes = round_up(payload, HUGE_PAGE_SIZE);
+        void *p = alloc_thp(bytes);
+        if (p) {
+            *buf = (GridBuffer){p, n_cells, bytes, GRID_BACKING_THP};
+            return 0;
+        }
+    }
+
+    size_t bytes = round_up(payload, GRID_ALIGNMENT);
+    void *p = NULL;
+    if (posix_memalign(&p, GRID_ALIGNMENT, bytes) != 0)
+        return -1;
+    *buf = (GridBuffer){p, n_cells, bytes, GRID_BACKING_HEAP};
+    return 0;
+}
+
+void grid_buffer_free(GridBuffer *buf) {
+    if (!buf->cells)
+        return;
+    if (buf->backing == GRID_BACKING_HEAP)
+        free(buf->cells);
+    else
+        munmap(buf->cells, buf->bytes);
+    memset(buf, 0, sizeof(*buf));
+}
+
+const char *grid_backing_name(GridBacking backing) {
+    switch (backing) {
+    case GRID_BACKING_HUGETLB:
+        return "hugetlb (2 MiB pages)";
+    case GRID_BACKING_THP:
+        return "transparent huge pages (madvise)";
+    case GRID_BACKING_HEAP:
+        return "heap (4 KiB pages)";
+    }
+    return "unknown";
+}
@@ -0,0 +1,28 @@
+#ifndef GRID_ALLOC_H
+#define GRID_ALLOC_H
+
+#include <stddef.h>
+#include "game_core.h"
+
+#define HUGE_PAGE_SIZE (2u * 1024u * 1024u)
+#define GRID_ALIGNMENT 64
+
+// Backings in order of preference; allocation degrades towards GRID_BACKING_HEAP.
+typedef enum {
+    GRID_BACKING_HUGETLB = 0,  // explicit 2 MiB pages via MAP_HUGETLB
+    GRID_BACKING_THP = 1,      // 2 MiB aligned mapping advised with MADV_HUGEPAGE
+    GRID_BACKING_HEAP = 2      // cache-line aligned heap memory
+} GridBacking;
+
+typedef struct {
+    CellState *cells;
+    size_t n_cells;
+    size_t bytes;  // length actually reserved, rounded up for page-backed buffers
+    GridBacking backing;
+} GridBuffer;
+
+int grid_buffer_alloc(GridBuffer *buf, size_t n_cells, GridBacking preferred);
+void grid_buffer_free(GridBuffer *buf);
+const char *grid_backing_name(GridBacking backing);
+
+#endif
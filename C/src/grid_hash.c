@@ -0,0 +1,136 @@
+#include "grid_hash.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SEED_LO 0x9e3779b97f4a7c15ULL
+#define SEED_HI 0xc2b2ae3d27d4eb4fULL
+#define PRIME_LO 0x87c37b91114253d5ULL
+#define PRIME_HI 0x4cf5ad432745937fULL
+#define ROW_KEY_LO 0xff51afd7ed558ccdULL
+#define ROW_KEY_HI 0xc4ceb9fe1a85ec53ULL
+
+// MurmurHash3 finalizer
+static uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+static uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// Cells [0, n) of a row as one word, n <= 64. Written as a plain reduction so
+// the compiler vectorizes it.
+static uint64_t pack_word(const CellState *cells, int n) {
+    uint64_t word = 0;
+    for (int i = 0; i < n; i++)
+        word |= (uint64_t)(cells[i] != DEAD) << i;
+    return word;
+}
+
+// A NULL row hashes as all dead.
+GridHash128 grid_row_hash(const CellState *row, int cols) {
+    uint64_t lo = SEED_LO ^ (uint64_t)cols, hi = SEED_HI ^ (uint64_t)cols;
+    for (int x = 0; x < cols; x += 64) {
+        uint64_t w = row ? pack_word(row + x, cols - x < 64 ? cols - x : 64) : 0;
+        lo = rotl64(lo ^ w, 31) * PRIME_LO;
+        hi = (rotl64(hi, 27) + w) * PRIME_HI;
+    }
+    return (GridHash128){fmix64(lo), fmix64(hi ^ lo)};
+}
+
+// Row y's contribution to the grid sums; the row index keeps rows ordered.
+static uint64_t spread_lo(GridHash128 row_hash, int y) {
+    return fmix64(row_hash.lo ^ (uint64_t)(y + 1) * ROW_KEY_LO);
+}
+
+static uint64_t spread_hi(GridHash128 row_hash, int y) {
+    return fmix64(row_hash.hi ^ (uint64_t)(y + 1) * ROW_KEY_HI);
+}
+
+static GridHash128 finish(uint64_t sum_lo, uint64_t sum_hi, int cols, int rows) {
+    uint64_t size = (uint64_t)(uint32_t)cols << 32 | (uint32_t)rows;
+    return (GridHash128){fmix64(sum_lo ^ size), fmix64(sum_hi + size * PRIME_HI)};
+}
+
+GridHash128 grid_hash128(const CellState *grid, int cols, int rows) {
+    uint64_t sum_lo = 0, sum_hi = 0;
+    for (int y = 0; y < rows; y++) {
+        GridHash128 r = grid_row_hash(grid + (size_t)y * cols, cols);
+        sum_lo += spread_lo(r, y);
+        sum_hi += spread_hi(r, y);
+    }
+    return finish(sum_lo, sum_hi, cols, rows);
+}
+
+uint64_t grid_hash64(const CellState *grid, int cols, int rows) {
+    return grid_hash128(grid, cols, rows).lo;
+}
+
+int grid_hash_equal(GridHash128 a, GridHash128 b) {
+    return a.lo == b.lo && a.hi == b.hi;
+}
+
+// Cells compare by same_cell, matching the hashes.
+int grid_equal(const CellState *a, const CellState *b, size_t n_cells) {
+    for (size_t i = 0; i < n_cells; i++)
+        if (!same_cell(a[i], b[i]))
+            return 0;
+    return 1;
+}
+
+size_t grid_diff_count(const CellState *a, const CellState *b, size_t n_cells) {
+    size_t n = 0;
+    for (size_t i = 0; i < n_cells; i++)
+        n += !same_cell(a[i], b[i]);
+    return n;
+}
+
+// Starts out describing an all-dead grid.
+int row_hashes_init(RowHashes *h, int cols, int rows) {
+    memset(h, 0, sizeof(*h));
+    if (cols < 1 || rows < 1)
+        return -1;
+    h->row_hashes = malloc(rows * sizeof(GridHash128));
+    if (!h->row_hashes)
+        return -1;
+    h->cols = cols;
+    h->rows = rows;
+    GridHash128 empty = grid_row_hash(NULL, cols);
+    for (int y = 0; y < rows; y++) {
+        h->row_hashes[y] = empty;
+        h->sum_lo += spread_lo(empty, y);
+        h->sum_hi += spread_hi(empty, y);
+    }
+    return 0;
+}
+
+void row_hashes_free(RowHashes *h) {
+    free(h->row_hashes);
+    memset(h, 0, sizeof(*h));
+}
+
+void row_hashes_compute(RowHashes *h, const CellState *grid) {
+    h->sum_lo = h->sum_hi = 0;
+    for (int y = 0; y < h->rows; y++) {
+        GridHash128 r = grid_row_hash(grid + (size_t)y * h->cols, h->cols);
+        h->row_hashes[y] = r;
+        h->sum_lo += spread_lo(r, y);
+        h->sum_hi += spread_hi(r, y);
+    }
+}
+
+void row_hashes_set(RowHashes *h, int y, GridHash128 row_hash) {
+    GridHash128 old = h->row_hashes[y];
+    h->sum_lo += spread_lo(row_hash, y) - spread_lo(old, y);
+    h->sum_hi += spread_hi(row_hash, y) - spread_hi(old, y);
+    h->row_hashes[y] = row_hash;
+}
+
+GridHash128 row_hashes_grid(const RowHashes *h) {
+    return finish(h->sum_lo, h->sum_hi, h->cols, h->rows);
+}
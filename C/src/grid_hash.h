@@ -0,0 +1,42 @@
+#ifndef GRID_HASH_H
+#define GRID_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "game_core.h"
+
+// Grid fingerprints. Cells are packed one bit per cell (bit i of word k is
+// cell 64k + i of the row) and hashed as 64-bit integers, so a hash depends
+// only on the cell states and the grid size: it is identical across
+// platforms, compilers and CellState representations. grid_hash64 is the lo
+// half of grid_hash128.
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+} GridHash128;
+
+GridHash128 grid_row_hash(const CellState *row, int cols);
+GridHash128 grid_hash128(const CellState *grid, int cols, int rows);
+uint64_t grid_hash64(const CellState *grid, int cols, int rows);
+int grid_hash_equal(GridHash128 a, GridHash128 b);
+int grid_equal(const CellState *a, const CellState *b, size_t n_cells);
+size_t grid_diff_count(const CellState *a, const CellState *b, size_t n_cells);
+
+// Per-row hashes kept alongside a grid. The grid hash is an order-dependent
+// sum over rows, so replacing one row's hash updates it in constant time.
+// compute_new_generation_hashed (game_core.h) keeps them current while stepping.
+struct RowHashes {
+    int cols;
+    int rows;
+    GridHash128 *row_hashes;
+    uint64_t sum_lo;
+    uint64_t sum_hi;
+};
+
+int row_hashes_init(RowHashes *h, int cols, int rows);
+void row_hashes_free(RowHashes *h);
+void row_hashes_compute(RowHashes *h, const CellState *grid);
+void row_hashes_set(RowHashes *h, int y, GridHash128 row_hash);
+GridHash128 row_hashes_grid(const RowHashes *h);
+
+#endif
@@ -0,0 +1,125 @@
+#include "grid_pool.h"
+#include <pthread.h>
+#include <string.h>
+
+typedef struct {
+    size_t n_cells;  // 0 while the class is unused
+    int count;
+    uint64_t last_used;
+    GridBuffer buffers[GRID_POOL_DEPTH];
+} PoolClass;
+
+typedef struct {
+    PoolClass classes[GRID_POOL_CLASSES];
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t clock;  // ticks on every free, for least-recently-used eviction
+    int registered;  // thread-exit destructor installed
+} Arena;
+
+static _Thread_local Arena arena;
+static pthread_key_t arena_key;
+static pthread_once_t arena_key_once = PTHREAD_ONCE_INIT;
+
+static void arena_exit(void *unused) {
+    (void)unused;
+    grid_pool_trim();
+}
+
+static void create_arena_key(void) {
+    pthread_key_create(&arena_key, arena_exit);
+}
+
+// The key only carries the destructor that releases a thread's buffers.
+static void register_arena(void) {
+    if (arena.registered)
+        return;
+    pthread_once(&arena_key_once, create_arena_key);
+    pthread_setspecific(arena_key, &arena);
+    arena.registered = 1;
+}
+
+static PoolClass *find_class(size_t n_cells) {
+    for (int i = 0; i < GRID_POOL_CLASSES; i++) {
+        if (arena.classes[i].n_cells == n_cells)
+            return &arena.classes[i];
+    }
+    return NULL;
+}
+
+// An unused class, or else the least recently used one, emptied.
+static PoolClass *claim_class(void) {
+    PoolClass *oldest = &arena.classes[0];
+    for (int i = 0; i < GRID_POOL_CLASSES; i++) {
+        PoolClass *c = &arena.classes[i];
+        if (c->n_cells == 0)
+            return c;
+        if (c->last_used < oldest->last_used)
+            oldest = c;
+    }
+    while (oldest->count > 0)
+        grid_buffer_free(&oldest->buffers[--oldest->count]);
+    oldest->n_cells = 0;
+    return oldest;
+}
+
+// Large grids ask for transparent huge pages, small ones for the heap.
+int grid_pool_alloc(GridBuffer *buf, size_t n_cells) {
+    PoolClass *c = find_class(n_cells);
+    if (c && c->count > 0) {
+        *buf = c->buffers[--c->count];
+        if (c->count == 0)
+            c->n_cells = 0;
+        memset(buf->cells, 0, n_cells * sizeof(CellState));
+        arena.hits++;
+        return 0;
+    }
+    arena.misses++;
+    GridBacking backing = n_cells * sizeof(CellState) >= HUGE_PAGE_SIZE ? GRID_BACKING_THP : GRID_BACKING_HEAP;
+    if (grid_buffer_alloc(buf, n_cells, backing) != 0)
+        return -1;
+    if (buf->backing == GRID_BACKING_HEAP)
+        memset(buf->cells, 0, n_cells * sizeof(CellState));
+    return 0;
+}
+
+// Keeps the buffer in this thread's arena while its size class has room. A
+// new size takes over the least recently used class when all are in use.
+void grid_pool_free(GridBuffer *buf) {
+    if (!buf->cells)
+        return;
+    PoolClass *c = find_class(buf->n_cells);
+    if (!c)
+        c = claim_class();
+    if (c->count < GRID_POOL_DEPTH) {
+        register_arena();
+        c->n_cells = buf->n_cells;
+        c->last_used = ++arena.clock;
+        c->buffers[c->count++] = *buf;
+        memset(buf, 0, sizeof(*buf));
+        return;
+    }
+    grid_buffer_free(buf);
+}
+
+// Releases every buffer cached by the calling thread.
+void grid_pool_trim(void) {
+    for (int i = 0; i < GRID_POOL_CLASSES; i++) {
+        PoolClass *c = &arena.classes[i];
+        while (c->count > 0)
+            grid_buffer_free(&c->buffers[--c->count]);
+        c->n_cells = 0;
+    }
+}
+
+void grid_pool_stats(GridPoolStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->hits = arena.hits;
+    stats->misses = arena.misses;
+    for (int i = 0; i < GRID_POOL_CLASSES; i++) {
+        for (int k = 0; k < arena.classes[i].count; k++) {
+            stats->cached++;
+            stats->cached_bytes += arena.classes[i].buffers[k].bytes;
+        }
+    }
+}
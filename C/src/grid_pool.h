@@ -0,0 +1,28 @@
+#ifndef GRID_POOL_H
+#define GRID_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "grid_alloc.h"
+
+#define GRID_POOL_CLASSES 8  // distinct grid sizes cached per thread
+#define GRID_POOL_DEPTH 8    // buffers cached per size
+
+// Per-thread arena of grid buffers. Freed buffers are kept, keyed by exact
+// cell count, and handed back zeroed by the next allocation of that size on
+// the same thread, so short-lived universes reuse warm, already faulted
+// memory instead of going through malloc or mmap. Buffers may be freed on a
+// different thread than the one that allocated them.
+typedef struct {
+    uint64_t hits;      // allocations served from the arena
+    uint64_t misses;    // allocations that fell through to grid_buffer_alloc
+    size_t cached;      // buffers held by the arena now
+    size_t cached_bytes;
+} GridPoolStats;
+
+int grid_pool_alloc(GridBuffer *buf, size_t n_cells);
+void grid_pool_free(GridBuffer *buf);
+void grid_pool_trim(void);
+void grid_pool_stats(GridPoolStats *stats);
+
+#endif
@@ -0,0 +1,186 @@
+#include "hensel.h"
+#include <ctype.h>
+#include <string.h>
+
+// Neighbors in ring order, clockwise from the top-left corner. Rotating a
+// ring mask by two bits turns the neighborhood by 90 degrees.
+static const int ring_dx[8] = {-1, 0, 1, 1, 1, 0, -1, -1};
+static const int ring_dy[8] = {-1, -1, -1, 0, 1, 1, 1, 0};
+
+// Letters valid for 1-4 neighbors; 5-7 reuse the letters of 8 - n and
+// denote the complementary neighborhoods.
+static const char *letters[5] = {"", "ce", "cekain", "cekainyqjr", "cekainyqjrtwz"};
+
+// One representative ring mask per letter, in the order of letters[n].
+static const uint8_t representatives[5][13] = {
+    {0},
+    {0x01, 0x02},
+    {0x05, 0x0a, 0x21, 0x03, 0x22, 0x11},
+    {0x15, 0x2a, 0x29, 0x0e, 0x07, 0x0d, 0x25, 0x13, 0x0b, 0x23},
+    {0x55, 0xaa, 0x2d, 0x0f, 0x8d, 0x17, 0x35, 0x93, 0x8b, 0xca, 0x27, 0x1b, 0x33},
+};
+
+static uint8_t ring_rotate(uint8_t ring) {
+    return (uint8_t)((ring << 2) | (ring >> 6));
+}
+
+// Mirror across the vertical axis: ring position i maps to (2 - i) mod 8.
+static uint8_t ring_mirror(uint8_t ring) {
+    uint8_t out = 0;
+    for (int i = 0; i < 8; i++) {
+        if ((ring >> i) & 1)
+            out |= 1u << ((10 - i) % 8);
+    }
+    return out;
+}
+
+static int ring_to_index(uint8_t ring, int center) {
+    int index = center << 4;
+    for (int i = 0; i < 8; i++) {
+        if ((ring >> i) & 1)
+            index |= 1 << (8 - ((ring_dy[i] + 1) * 3 + ring_dx[i] + 1));
+    }
+    return index;
+}
+
+static int ring_count(uint8_t ring) {
+    return __builtin_popcount(ring);
+}
+
+// Sets the transition for every rotation and reflection of the neighborhood.
+static void mark_orbit(HenselRule *rule, uint8_t ring, int center) {
+    for (int m = 0; m < 2; m++) {
+        for (int r = 0; r < 4; r++) {
+            rule->table[ring_to_index(ring, center)] = 1;
+            ring = ring_rotate(ring);
+        }
+        ring = ring_mirror(ring);
+    }
+}
+
+static void mark_count(HenselRule *rule, int count, int center) {
+    for (int ring = 0; ring < 256; ring++) {
+        if (ring_count((uint8_t)ring) == count)
+            rule->table[ring_to_index((uint8_t)ring, center)] = 1;
+    }
+}
+
+static int letter_ring(int count, char letter, uint8_t *ring) {
+    int base = count <= 4 ? count : 8 - count;
+    const char *pos = strchr(letters[base], letter);
+    if (!pos || !*pos)
+        return -1;
+    uint8_t rep = representatives[base][pos - letters[base]];
+    *ring = count <= 4 ? rep : (uint8_t)~rep;
+    return 0;
+}
+
+// Parses the count/letter list after B or S, e.g. "2-a" or "2ci3ai4c8".
+static const char *parse_transitions(HenselRule *rule, const char *s, int center) {
+    while (*s >= '0' && *s <= '8') {
+        int count = *s++ - '0';
+        int negate = 0;
+        if (*s == '-') {
+            negate = 1;
+            s++;
+        }
+
+        uint8_t chosen[13];
+        int n_chosen = 0;
+        while (isalpha((unsigned char)*s) && toupper((unsigned char)*s) != 'S' && toupper((unsigned char)*s) != 'B') {
+            uint8_t ring;
+            if (letter_ring(count, (char)tolower((unsigned char)*s), &ring) != 0)
+                return NULL;
+            chosen[n_chosen++] = ring;
+            s++;
+        }
+        if (negate && n_chosen == 0)
+            return NULL;
+
+        if (n_chosen == 0 || negate) {
+            mark_count(rule, count, center);
+            // Clear the excluded orbits again
+            HenselRule excluded;
+            memset(&excluded, 0, sizeof(excluded));
+            for (int i = 0; i < n_chosen; i++)
+                mark_orbit(&excluded, chosen[i], center);
+            for (int i = 0; i < HENSEL_TABLE_SIZE; i++) {
+                if (excluded.table[i])
+                    rule->table[i] = 0;
+            }
+        } else {
+            for (int i = 0; i < n_chosen; i++)
+                mark_orbit(rule, chosen[i], center);
+        }
+    }
+    return s;
+}
+
+// Accepts "B<transitions>/S<transitions>" in either order, any case, with
+// or without the slash; plain B/S rulestrings are the totalistic special case.
+int hensel_rule_parse(HenselRule *rule, const char *rulestring) {
+    int seen_birth = 0, seen_survive = 0;
+    const char *s = rulestring;
+    memset(rule, 0, sizeof(*rule));
+
+    while (*s) {
+        char c = (char)toupper((unsigned char)*s++);
+        if (c == 'B' && !seen_birth) {
+            s = parse_transitions(rule, s, 0);
+            seen_birth = 1;
+        } else if (c == 'S' && !seen_survive) {
+            s = parse_transitions(rule, s, 1);
+            seen_survive = 1;
+        } else {
+            return -1;
+        }
+        if (!s)
+            return -1;
+        if (*s == '/')
+            s++;
+    }
+    return seen_birth && seen_survive ? 0 : -1;
+}
+
+void hensel_rule_from_life(HenselRule *rule, const LifeRule *life) {
+    for (int index = 0; index < HENSEL_TABLE_SIZE; index++) {
+        int center = (index >> 4) & 1;
+        int count = __builtin_popcount(index & ~(1 << 4));
+        rule->table[index] = life->table[LIFE_RULE_INDEX(center, count)];
+    }
+}
+
+int hensel_index(const CellState *grid, int cols, int rows, int x, int y) {
+    int index = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        int row = (y + dy + rows) % rows;
+        for (int dx = -1; dx <= 1; dx++) {
+            int col = (x + dx + cols) % cols;
+            index = (index << 1) | (grid[row * cols + col] == ALIVE);
+        }
+    }
+    return index;
+}
+
+static int column_bits(const CellState *up, const CellState *mid, const CellState *down, int x) {
+    return (up[x] << 6) | (mid[x] << 3) | down[x];
+}
+
+// The index is built once per row and then slid right one column at a time,
+// reading three new cells per output instead of nine.
+void hensel_step(const CellState *curr_grid, CellState *next_grid, int cols, int rows, const HenselRule *rule) {
+    for (int y = 0; y < rows; y++) {
+        const CellState *up = curr_grid + (size_t)(y == 0 ? rows - 1 : y - 1) * cols;
+        const CellState *mid = curr_grid + (size_t)y * cols;
+        const CellState *down = curr_grid + (size_t)(y == rows - 1 ? 0 : y + 1) * cols;
+        CellState *out = next_grid + (size_t)y * cols;
+
+        int index = hensel_index(curr_grid, cols, rows, 0, y);
+        for (int x = 0; x < cols - 1; x++) {
+            out[x] = (CellState)rule->table[index];
+            int incoming = x + 2 < cols ? x + 2 : x + 2 - cols;
+            index = ((index << 1) & HENSEL_KEEP_MASK) | column_bits(up, mid, down, incoming);
+        }
+        out[cols - 1] = (CellState)rule->table[index];
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef HENSEL_H
+#define HENSEL_H
+
+#include <stdint.h>
+#include "game_core.h"
+#include "life_rule.h"
+
+#define HENSEL_TABLE_SIZE 512
+
+// Bit layout of a 3x3 neighborhood index, row-major from the top-left:
+//   NW N NE       256 128 64
+//   W  C  E   =    32  16  8
+//   SW S SE         4   2  1
+// Sliding one cell right is ((index << 1) & HENSEL_KEEP_MASK) | new column.
+#define HENSEL_KEEP_MASK 0666
+
+// Isotropic non-totalistic rule compiled from Hensel notation, e.g. "B2-a/S12".
+typedef struct {
+    uint8_t table[HENSEL_TABLE_SIZE];  // next state for each neighborhood index
+} HenselRule;
+
+int hensel_rule_parse(HenselRule *rule, const char *rulestring);
+void hensel_rule_from_life(HenselRule *rule, const LifeRule *life);
+int hensel_index(const CellState *grid, int cols, int rows, int x, int y);
+void hensel_step(const CellState *curr_grid, CellState *next_grid, int cols, int rows, const HenselRule *rule);
+
+#endif
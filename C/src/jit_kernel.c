@@ -0,0 +1,250 @@
+#include "jit_kernel.h"
+#include <dlfcn.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef JIT_CC
+#define JIT_CC "cc"
+#endif
+
+#define JIT_SYMBOL "gol_jit_step"
+// No -march=native: the cache key does not identify the CPU, and a cache
+// directory shared between machines must not hand out kernels using an ISA
+// extension the host lacks.
+#define JIT_CFLAGS "-O3 -shared -fPIC"
+// Bump when the generated source changes so stale cache entries are ignored.
+#define JIT_SOURCE_VERSION 1
+
+_Static_assert(sizeof(CellState) == sizeof(int), "generated kernels treat cells as int");
+
+static const char *kernel_template =
+    "/* Generated by jit_kernel.c - do not edit */\n"
+    "#include <stddef.h>\n"
+    "#define COLS %d\n"
+    "#define ROWS %d\n"
+    "#define STRIDE %d\n"
+    "#define TORUS %d\n"
+    "#define RULE_BITS %uu  /* birth mask | survive mask << 9 */\n"
+    "\n"
+    "static inline int next_state(int alive, int n) {\n"
+    "    return (RULE_BITS >> (n + 9 * alive)) & 1;\n"
+    "}\n"
+    "\n"
+    "void " JIT_SYMBOL "(const int *restrict curr, int *restrict next) {\n"
+    "#if !TORUS\n"
+    "    static const int dead_row[COLS];\n"
+    "#endif\n"
+    "    for (int y = 0; y < ROWS; y++) {\n"
+    "#if TORUS\n"
+    "        const int *up = curr + (size_t)(y == 0 ? ROWS - 1 : y - 1) * STRIDE;\n"
+    "        const int *down = curr + (size_t)(y == ROWS - 1 ? 0 : y + 1) * STRIDE;\n"
+    "        int left_edge = COLS - 1, right_edge = 0;\n"
+    "#else\n"
+    "        const int *up = y == 0 ? dead_row : curr + (size_t)(y - 1) * STRIDE;\n"
+    "        const int *down = y == ROWS - 1 ? dead_row : curr + (size_t)(y + 1) * STRIDE;\n"
+    "#endif\n"
+    "        const int *mid = curr + (size_t)y * STRIDE;\n"
+    "        int *out = next + (size_t)y * STRIDE;\n"
+    "#if TORUS\n"
+    "        out[0] = next_state(mid[0], up[left_edge] + up[0] + up[1] + mid[left_edge] + mid[1]\n"
+    "                                    + down[left_edge] + down[0] + down[1]);\n"
+    "#else\n"
+    "        out[0] = next_state(mid[0], up[0] + up[1] + mid[1] + down[0] + down[1]);\n"
+    "#endif\n"
+    "        for (int x = 1; x < COLS - 1; x++)\n"
+    "            out[x] = next_state(mid[x], up[x - 1] + up[x] + up[x + 1] + mid[x - 1] + mid[x + 1]\n"
+    "                                        + down[x - 1] + down[x] + down[x + 1]);\n"
+    "#if TORUS\n"
+    "        out[COLS - 1] = next_state(mid[COLS - 1], up[COLS - 2] + up[COLS - 1] + up[right_edge]\n"
+    "                                                  + mid[COLS - 2] + mid[right_edge]\n"
+    "                                                  + down[COLS - 2] + down[COLS - 1] + down[right_edge]);\n"
+    "#else\n"
+    "        out[COLS - 1] = next_state(mid[COLS - 1], up[COLS - 2] + up[COLS - 1] + mid[COLS - 2]\n"
+    "                                                  + down[COLS - 2] + down[COLS - 1]);\n"
+    "#endif\n"
+    "    }\n"
+    "}\n";
+
+void kernel_params_core(KernelParams *params, const LifeRule *rule) {
+    params->rule = *rule;
+    params->cols = GRID_COLS;
+    params->rows = GRID_ROWS;
+    params->stride = GRID_COLS;
+    params->boundary = BOUNDARY_TORUS;
+}
+
+static int is_core_geometry(const KernelParams *p) {
+    return p->cols == GRID_COLS && p->rows == GRID_ROWS && p->stride == GRID_COLS && p->boundary == BOUNDARY_TORUS;
+}
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len) {
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static uint64_t params_hash(const KernelParams *p, const char *compiler) {
+    int fields[] = {JIT_SOURCE_VERSION, p->rule.birth, p->rule.survive, p->cols, p->rows, p->stride, p->boundary};
+    uint64_t h = fnv1a(0xcbf29ce484222325ULL, fields, sizeof(fields));
+    h = fnv1a(h, compiler, strlen(compiler));
+    return fnv1a(h, JIT_CFLAGS, strlen(JIT_CFLAGS));
+}
+
+int jit_kernel_write_source(const KernelParams *params, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return -1;
+    unsigned rule_bits = params->rule.birth | (unsigned)params->rule.survive << 9;
+    int ok = fprintf(f, kernel_template, params->cols, params->rows, params->stride,
+                     params->boundary == BOUNDARY_TORUS, rule_bits) > 0;
+    return fclose(f) == 0 && ok ? 0 : -1;
+}
+
+static int mkdir_p(const char *path) {
+    char buf[256];
+    if (snprintf(buf, sizeof(buf), "%s", path) >= (int)sizeof(buf))
+        return -1;
+    for (char *p = buf + 1; *p; p++) {
+        if (*p != '/')
+            continue;
+        *p = '\0';
+        if (mkdir(buf, 0700) != 0 && errno != EEXIST)
+            return -1;
+        *p = '/';
+    }
+    return mkdir(buf, 0700) != 0 && errno != EEXIST ? -1 : 0;
+}
+
+// $XDG_CACHE_HOME/gol-jit, then ~/.cache/gol-jit, and only without a home
+// directory a per-user directory under $TMPDIR or /tmp.
+static const char *default_cache_dir(char *buf, size_t len) {
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    const char *tmp = getenv("TMPDIR");
+    if (xdg && *xdg == '/')
+        snprintf(buf, len, "%s/gol-jit", xdg);
+    else if (home && *home == '/')
+        snprintf(buf, len, "%s/.cache/gol-jit", home);
+    else
+        snprintf(buf, len, "%s/gol-jit-%d", tmp && *tmp ? tmp : "/tmp", (int)getuid());
+    return buf;
+}
+
+// Loaded objects run inside this process, so the cache directory must be a
+// real directory (not a symlink) owned by us with mode 0700; anyone else
+// able to write there could plant a kernel.
+static int is_private_dir(const char *path) {
+    struct stat st;
+    return lstat(path, &st) == 0 && S_ISDIR(st.st_mode) && st.st_uid == getuid() &&
+           (st.st_mode & 0777) == 0700;
+}
+
+// A cached kernel is trusted only as a regular file of ours that nobody
+// else can modify.
+static int is_trusted_object(const char *path) {
+    struct stat st;
+    return lstat(path, &st) == 0 && S_ISREG(st.st_mode) && st.st_uid == getuid() &&
+           (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+// Compiles to a private temporary name, then renames into place so
+// concurrent processes never load a half-written object.
+static int compile_kernel(const KernelParams *params, const char *compiler, const char *so_path) {
+    char src[600], tmp_so[600], cmd[2048];
+    snprintf(src, sizeof(src), "%s.%d.c", so_path, (int)getpid());
+    snprintf(tmp_so, sizeof(tmp_so), "%s.%d.tmp", so_path, (int)getpid());
+    if (jit_kernel_write_source(params, src) != 0)
+        return -1;
+
+    snprintf(cmd, sizeof(cmd), "%s " JIT_CFLAGS " -o '%s' '%s' 2>/dev/null", compiler, tmp_so, src);
+    int rc = system(cmd);
+    remove(src);
+    if (rc != 0 || chmod(tmp_so, 0700) != 0 || rename(tmp_so, so_path) != 0) {
+        remove(tmp_so);
+        return -1;
+    }
+    return 0;
+}
+
+int jit_kernel_init(JitKernel *kernel, const KernelParams *params, const char *cache_dir) {
+    char dir_buf[256];
+    memset(kernel, 0, sizeof(*kernel));
+    if (params->cols < 3 || params->rows < 1 || params->stride < params->cols)
+        return -1;
+    kernel->params = *params;
+
+    const char *compiler = getenv("GOL_JIT_CC");
+    if (!compiler || !*compiler)
+        compiler = JIT_CC;
+    if (!cache_dir)
+        cache_dir = default_cache_dir(dir_buf, sizeof(dir_buf));
+    if (strchr(cache_dir, '\'') || mkdir_p(cache_dir) != 0 || !is_private_dir(cache_dir))
+        return 0;
+
+    snprintf(kernel->path, sizeof(kernel->path), "%s/kernel-%016llx.so", cache_dir,
+             (unsigned long long)params_hash(params, compiler));
+
+    // An untrusted entry is rebuilt; the rename replaces it.
+    kernel->cache_hit = is_trusted_object(kernel->path);
+    if (!kernel->cache_hit && compile_kernel(params, compiler, kernel->path) != 0)
+        return 0;
+    if (!is_trusted_object(kernel->path))
+        return 0;
+
+    kernel->handle = dlopen(kernel->path, RTLD_NOW | RTLD_LOCAL);
+    if (!kernel->handle)
+        return 0;
+    kernel->step = (JitStepFn)dlsym(kernel->handle, JIT_SYMBOL);
+    if (!kernel->step) {
+        dlclose(kernel->handle);
+        kernel->handle = NULL;
+    }
+    return 0;
+}
+
+void jit_kernel_free(JitKernel *kernel) {
+    if (kernel->handle)
+        dlclose(kernel->handle);
+    memset(kernel, 0, sizeof(*kernel));
+}
+
+static CellState generic_cell(const KernelParams *p, const CellState *grid, int x, int y) {
+    if (p->boundary == BOUNDARY_TORUS) {
+        x = (x + p->cols) % p->cols;
+        y = (y + p->rows) % p->rows;
+    } else if (x < 0 || x >= p->cols || y < 0 || y >= p->rows) {
+        return DEAD;
+    }
+    return grid[(size_t)y * p->stride + x];
+}
+
+static void generic_step(const KernelParams *p, const CellState *curr_grid, CellState *next_grid) {
+    for (int y = 0; y < p->rows; y++) {
+        for (int x = 0; x < p->cols; x++) {
+            int alive_count = 0;
+            for (int y_off = -1; y_off <= 1; y_off++)
+                for (int x_off = -1; x_off <= 1; x_off++)
+                    if (x_off || y_off)
+                        alive_count += generic_cell(p, curr_grid, x + x_off, y + y_off);
+            CellState state = curr_grid[(size_t)y * p->stride + x];
+            next_grid[(size_t)y * p->stride + x] = (CellState)p->rule.table[LIFE_RULE_INDEX(state, alive_count)];
+        }
+    }
+}
+
+void jit_kernel_step(const JitKernel *kernel, const CellState *curr_grid, CellState *next_grid) {
+    if (kernel->step)
+        kernel->step(curr_grid, next_grid);
+    else if (is_core_geometry(&kernel->params))
+        compute_new_generation_rule(curr_grid, next_grid, &kernel->params.rule);
+    else
+        generic_step(&kernel->params, curr_grid, next_grid);
+}
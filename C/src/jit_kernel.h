@@ -0,0 +1,39 @@
+#ifndef JIT_KERNEL_H
+#define JIT_KERNEL_H
+
+#include "game_core.h"
+#include "life_rule.h"
+
+typedef enum {
+    BOUNDARY_TORUS = 0,  // edges wrap, as in pos_to_index
+    BOUNDARY_DEAD = 1    // cells outside the grid are always dead
+} Boundary;
+
+typedef struct {
+    LifeRule rule;
+    int cols;
+    int rows;
+    int stride;  // cells between the starts of consecutive rows, >= cols
+    Boundary boundary;
+} KernelParams;
+
+typedef void (*JitStepFn)(const CellState *curr_grid, CellState *next_grid);
+
+// A step kernel with its parameters baked in as constants, compiled at
+// runtime with the local C compiler and loaded with dlopen. When compiling
+// or loading fails, jit_kernel_step runs a generic kernel instead.
+typedef struct {
+    KernelParams params;
+    void *handle;
+    JitStepFn step;    // NULL when running the generic fallback
+    int cache_hit;     // shared object was already in the cache
+    char path[512];    // cached shared object
+} JitKernel;
+
+int jit_kernel_init(JitKernel *kernel, const KernelParams *params, const char *cache_dir);
+void jit_kernel_free(JitKernel *kernel);
+void jit_kernel_step(const JitKernel *kernel, const CellState *curr_grid, CellState *next_grid);
+void kernel_params_core(KernelParams *params, const LifeRule *rule);
+int jit_kernel_write_source(const KernelParams *params, const char *path);
+
+#endif
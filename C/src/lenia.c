@@ -0,0 +1,238 @@
+#include "lenia.h"
+#include "game_core.h"
+#include "parallel.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+const LeniaParams LENIA_ORBIUM = {13, 1, {1.0f}, 0.15f, 0.015f, 0.1f};
+
+// Work slots per pool thread, so uneven slots still balance out
+#define SLOTS_PER_THREAD 4
+
+typedef struct Pass Pass;
+typedef void (*SlotFn)(Pass *pass, int begin, int end, double complex *buf);
+
+struct Pass {
+    Lenia *lenia;
+    const float *src;
+    float *dst;
+    const float *curr;
+    int n_items;  // rows, row pairs or columns split over the slots
+    SlotFn fn;
+};
+
+// Slot s owns items [n * s / n_slots, n * (s + 1) / n_slots) and its own
+// buffer, so each slot runs on one thread at a time and nothing is allocated.
+static void run_slots(int begin, int end, void *ctx) {
+    Pass *pass = ctx;
+    Lenia *l = pass->lenia;
+    for (int slot = begin; slot < end; slot++) {
+        int lo = (int)((long long)pass->n_items * slot / l->n_slots);
+        int hi = (int)((long long)pass->n_items * (slot + 1) / l->n_slots);
+        if (lo < hi)
+            pass->fn(pass, lo, hi, l->slot_buffers + (size_t)slot * l->slot_size);
+    }
+}
+
+static void for_slots(Pass *pass, int n_items, SlotFn fn) {
+    pass->n_items = n_items;
+    pass->fn = fn;
+    parallel_for(0, pass->lenia->n_slots, run_slots, pass);
+}
+
+// Unnormalized ring profile, before the kernel is scaled to sum to one.
+static double kernel_shell(const LeniaParams *params, int dx, int dy) {
+    double r = sqrt((double)dx * dx + (double)dy * dy) / params->radius * params->n_rings;
+    if (r >= params->n_rings)
+        return 0.0;
+    int ring = (int)r;
+    double t = r - ring;
+    if (t <= 0.0)
+        return 0.0;
+    return params->rings[ring] * exp(4.0 - 1.0 / (t * (1.0 - t)));
+}
+
+static double kernel_total(const LeniaParams *params) {
+    double total = 0.0;
+    for (int y = -params->radius; y <= params->radius; y++) {
+        for (int x = -params->radius; x <= params->radius; x++)
+            total += kernel_shell(params, x, y);
+    }
+    return total;
+}
+
+float lenia_kernel_weight(const LeniaParams *params, int dx, int dy) {
+    double total = kernel_total(params);
+    return total > 0.0 ? (float)(kernel_shell(params, dx, dy) / total) : 0.0f;
+}
+
+// Rows 2p and 2p + 1 go through one complex FFT as real and imaginary parts
+// and are separated using the Hermitian symmetry of real-input spectra.
+static void rows_forward(Pass *pass, int begin, int end, double complex *buf) {
+    Lenia *l = pass->lenia;
+    int n = l->cols;
+    double complex *z = buf, *scratch = buf + n;
+    for (int p = begin; p < end; p++) {
+        int y = 2 * p, paired = y + 1 < l->rows;
+        const float *a = pass->src + (size_t)y * n;
+        const float *b = paired ? a + n : NULL;
+        for (int x = 0; x < n; x++)
+            z[x] = CMPLX(a[x], b ? b[x] : 0.0);
+        fft_execute(l->row_plan, z, 0, scratch);
+        double complex *sa = l->spectrum + (size_t)y * l->spec_cols;
+        double complex *sb = sa + l->spec_cols;
+        for (int k = 0; k < l->spec_cols; k++) {
+            double complex zk = z[k], zn = conj(z[(n - k) % n]);
+            sa[k] = (zk + zn) * 0.5;
+            if (paired)
+                sb[k] = (zk - zn) * (-0.5 * I);
+        }
+    }
+}
+
+static void rows_inverse(Pass *pass, int begin, int end, double complex *buf) {
+    Lenia *l = pass->lenia;
+    int n = l->cols;
+    double complex *z = buf, *scratch = buf + n;
+    for (int p = begin; p < end; p++) {
+        int y = 2 * p, paired = y + 1 < l->rows;
+        const double complex *sa = l->spectrum + (size_t)y * l->spec_cols;
+        const double complex *sb = sa + l->spec_cols;
+        for (int k = 0; k < n; k++) {
+            int h = k < l->spec_cols ? k : n - k;
+            double complex a = k < l->spec_cols ? sa[h] : conj(sa[h]);
+            double complex b = paired ? (k < l->spec_cols ? sb[h] : conj(sb[h])) : 0.0;
+            z[k] = a + I * b;
+        }
+        fft_execute(l->row_plan, z, 1, scratch);
+        float *a = pass->dst + (size_t)y * n;
+        for (int x = 0; x < n; x++) {
+            a[x] = (float)creal(z[x]);
+            if (paired)
+                a[n + x] = (float)cimag(z[x]);
+        }
+    }
+}
+
+// Column transforms over the half spectrum; the inverse pass also applies
+// the kernel, so the spectrum is only walked once between the row passes.
+static void columns(Lenia *l, int begin, int end, int inverse, double complex *buf) {
+    double complex *col = buf, *scratch = buf + l->rows;
+    for (int k = begin; k < end; k++) {
+        double complex *s = l->spectrum + k;
+        if (inverse) {
+            const double complex *kern = l->kernel_spectrum + k;
+            for (int y = 0; y < l->rows; y++)
+                col[y] = s[(size_t)y * l->spec_cols] * kern[(size_t)y * l->spec_cols];
+        } else {
+            for (int y = 0; y < l->rows; y++)
+                col[y] = s[(size_t)y * l->spec_cols];
+        }
+        fft_execute(l->col_plan, col, inverse, scratch);
+        for (int y = 0; y < l->rows; y++)
+            s[(size_t)y * l->spec_cols] = col[y];
+    }
+}
+
+static void columns_forward(Pass *pass, int begin, int end, double complex *buf) {
+    columns(pass->lenia, begin, end, 0, buf);
+}
+
+static void columns_inverse(Pass *pass, int begin, int end, double complex *buf) {
+    columns(pass->lenia, begin, end, 1, buf);
+}
+
+static void forward_2d(Lenia *l, const float *grid) {
+    Pass pass = {l, grid, NULL, NULL, 0, NULL};
+    for_slots(&pass, (l->rows + 1) / 2, rows_forward);
+    for_slots(&pass, l->spec_cols, columns_forward);
+}
+
+int lenia_init(Lenia *lenia, int cols, int rows, const LeniaParams *params) {
+    memset(lenia, 0, sizeof(*lenia));
+    if (cols < 1 || rows < 1 || params->radius < 1 || params->n_rings < 1 ||
+        params->n_rings > LENIA_MAX_RINGS || params->sigma <= 0.0f)
+        return -1;
+    lenia->cols = cols;
+    lenia->rows = rows;
+    lenia->spec_cols = cols / 2 + 1;
+    lenia->params = *params;
+    lenia->row_plan = fft_plan_get(cols);
+    lenia->col_plan = fft_plan_get(rows);
+
+    if (!lenia->row_plan || !lenia->col_plan) {
+        lenia_free(lenia);
+        return -1;
+    }
+
+    size_t spec = (size_t)rows * lenia->spec_cols;
+    size_t cells = (size_t)rows * cols;
+    size_t row_slot = cols + fft_scratch_size(lenia->row_plan);
+    size_t col_slot = rows + fft_scratch_size(lenia->col_plan);
+    lenia->n_slots = parallel_thread_count() * SLOTS_PER_THREAD;
+    lenia->slot_size = row_slot > col_slot ? row_slot : col_slot;
+    lenia->slot_buffers = malloc((size_t)lenia->n_slots * lenia->slot_size * sizeof(double complex));
+    lenia->kernel_spectrum = malloc(spec * sizeof(double complex));
+    lenia->spectrum = malloc(spec * sizeof(double complex));
+    lenia->potential = calloc(cells, sizeof(float));
+    if (!lenia->slot_buffers || !lenia->kernel_spectrum || !lenia->spectrum || !lenia->potential) {
+        lenia_free(lenia);
+        return -1;
+    }
+
+    // Kernel image centred on cell (0, 0); offsets wrap like pos_to_index, so
+    // a kernel wider than the torus folds onto itself.
+    int r = params->radius;
+    double total = kernel_total(params);
+    if (total <= 0.0) {
+        lenia_free(lenia);
+        return -1;
+    }
+    for (int dy = -r; dy <= r; dy++) {
+        for (int dx = -r; dx <= r; dx++)
+            lenia->potential[wrap_index(dx, dy, cols, rows)] += (float)(kernel_shell(params, dx, dy) / total);
+    }
+    forward_2d(lenia, lenia->potential);
+    double scale = 1.0 / ((double)cols * rows);
+    for (size_t i = 0; i < spec; i++)
+        lenia->kernel_spectrum[i] = lenia->spectrum[i] * scale;
+    memset(lenia->potential, 0, cells * sizeof(float));
+    return 0;
+}
+
+void lenia_free(Lenia *lenia) {
+    free(lenia->slot_buffers);
+    free(lenia->kernel_spectrum);
+    free(lenia->spectrum);
+    free(lenia->potential);
+    memset(lenia, 0, sizeof(*lenia));
+}
+
+// potential = kernel (*) grid, circular in both directions.
+void lenia_convolve(Lenia *lenia, const float *grid) {
+    Pass pass = {lenia, grid, lenia->potential, NULL, 0, NULL};
+    forward_2d(lenia, grid);
+    for_slots(&pass, lenia->spec_cols, columns_inverse);
+    for_slots(&pass, (lenia->rows + 1) / 2, rows_inverse);
+}
+
+static void grow_rows(int begin, int end, void *ctx) {
+    Pass *pass = ctx;
+    const LeniaParams *p = &pass->lenia->params;
+    float inv_two_var = 1.0f / (2.0f * p->sigma * p->sigma);
+    size_t from = (size_t)begin * pass->lenia->cols, to = (size_t)end * pass->lenia->cols;
+    for (size_t i = from; i < to; i++) {
+        float d = pass->src[i] - p->mu;
+        float growth = 2.0f * expf(-d * d * inv_two_var) - 1.0f;
+        float v = pass->curr[i] + p->dt * growth;
+        pass->dst[i] = v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v;
+    }
+}
+
+// next = clip(curr + dt * G(K * curr), 0, 1). The grids may alias.
+void lenia_step(Lenia *lenia, const float *curr_grid, float *next_grid) {
+    lenia_convolve(lenia, curr_grid);
+    Pass pass = {lenia, lenia->potential, next_grid, curr_grid, 0, NULL};
+    parallel_for(0, lenia->rows, grow_rows, &pass);
+}
@@ -0,0 +1,47 @@
+#ifndef LENIA_H
+#define LENIA_H
+
+#include <complex.h>
+#include "fft.h"
+
+#define LENIA_MAX_RINGS 4
+
+// Lenia parameters: a kernel of concentric smooth rings of the given peak
+// heights, and a Gaussian growth mapping. Orbium is R13, T10, mu 0.15,
+// sigma 0.015 with a single ring of height 1.
+typedef struct {
+    int radius;
+    int n_rings;
+    float rings[LENIA_MAX_RINGS];
+    float mu;
+    float sigma;
+    float dt;                       // 1 / T
+} LeniaParams;
+
+// Continuous CA on a torus. The kernel convolution runs in frequency space:
+// real rows are transformed two at a time, so the spectrum keeps only the
+// cols / 2 + 1 non-redundant columns, and the kernel spectrum is computed once.
+typedef struct {
+    int cols;
+    int rows;
+    int spec_cols;                  // cols / 2 + 1
+    LeniaParams params;
+    const FftPlan *row_plan;
+    const FftPlan *col_plan;
+    double complex *kernel_spectrum;  // rows x spec_cols, scaled for the inverse
+    double complex *spectrum;         // rows x spec_cols work buffer
+    float *potential;                 // kernel convolved with the last input
+    int n_slots;                      // parallel work slots, fixed at init
+    size_t slot_size;                 // FFT line plus scratch, in elements
+    double complex *slot_buffers;     // n_slots x slot_size
+} Lenia;
+
+extern const LeniaParams LENIA_ORBIUM;
+
+int lenia_init(Lenia *lenia, int cols, int rows, const LeniaParams *params);
+void lenia_free(Lenia *lenia);
+void lenia_convolve(Lenia *lenia, const float *grid);
+void lenia_step(Lenia *lenia, const float *curr_grid, float *next_grid);
+float lenia_kernel_weight(const LeniaParams *params, int dx, int dy);
+
+#endif
@@ -0,0 +1,292 @@
+#include "life3d.h"
+#include "bitslice.h"
+#include "parallel.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Survive on 4-5 neighbors, birth on 5 (Bays).
+const Life3dRule LIFE3D_RULE_4555 = {1u << 5, (1u << 4) | (1u << 5)};
+
+static uint32_t count_range(long lo, long hi) {
+    uint32_t mask = 0;
+    for (long n = lo; n <= hi; n++)
+        mask |= 1u << n;
+    return mask;
+}
+
+// Comma-separated counts and lo-hi ranges, e.g. "4,5,12-14".
+static int parse_counts(const char *s, const char *end, uint32_t *mask) {
+    *mask = 0;
+    while (s < end) {
+        char *stop;
+        long lo = strtol(s, &stop, 10), hi = lo;
+        if (stop == s)
+            return -1;
+        if (*stop == '-') {
+            s = stop + 1;
+            hi = strtol(s, &stop, 10);
+            if (stop == s)
+                return -1;
+        }
+        if (lo < 0 || hi < lo || hi > LIFE3D_MAX_NEIGHBORS || stop > end)
+            return -1;
+        *mask |= count_range(lo, hi);
+        s = stop;
+        if (s < end && *s++ != ',')
+            return -1;
+    }
+    return 0;
+}
+
+// Accepts Bays' E_l E_u F_l F_u notation ("4555", or "4,5,5,5" for counts
+// above 9): survive on E_l..E_u, birth on F_l..F_u. Also accepts "B5/S4-5".
+int life3d_rule_parse(Life3dRule *rule, const char *rulestring) {
+    const char *slash = strchr(rulestring, '/');
+    memset(rule, 0, sizeof(*rule));
+
+    if (toupper((unsigned char)rulestring[0]) == 'B' && slash &&
+        toupper((unsigned char)slash[1]) == 'S') {
+        return parse_counts(rulestring + 1, slash, &rule->birth) == 0 &&
+               parse_counts(slash + 2, slash + 2 + strlen(slash + 2), &rule->survive) == 0 ? 0 : -1;
+    }
+
+    long v[4];
+    size_t len = strlen(rulestring);
+    if (len == 4 && strspn(rulestring, "0123456789") == 4) {
+        for (int i = 0; i < 4; i++)
+            v[i] = rulestring[i] - '0';
+    } else {
+        const char *s = rulestring;
+        for (int i = 0; i < 4; i++) {
+            char *stop;
+            v[i] = strtol(s, &stop, 10);
+            if (stop == s || *stop != (i < 3 ? ',' : '\0'))
+                return -1;
+            s = stop + 1;
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        if (v[i] < 0 || v[i] > LIFE3D_MAX_NEIGHBORS)
+            return -1;
+    }
+    if (v[1] < v[0] || v[3] < v[2])
+        return -1;
+    rule->survive = count_range(v[0], v[1]);
+    rule->birth = count_range(v[2], v[3]);
+    return 0;
+}
+
+// pos_to_index for a volume: coordinates wrap in all three axes.
+int life3d_index(int x, int y, int z, int cols, int rows, int depth) {
+    z = (z % depth + depth) % depth;
+    return z * cols * rows + wrap_index(x, y, cols, rows);
+}
+
+// Bit-planes per plane sum; see plane_sum.
+#define PLANE_BITS 4
+
+static uint64_t *row_ptr(const Life3dGrid *g, int y, int z) {
+    return g->words + ((size_t)z * g->rows + y) * g->words_per_row;
+}
+
+int life3d_grid_init(Life3dGrid *g, int cols, int rows, int depth) {
+    memset(g, 0, sizeof(*g));
+    if (cols < 1 || rows < 1 || depth < 1)
+        return -1;
+    g->cols = cols;
+    g->rows = rows;
+    g->depth = depth;
+    g->words_per_row = (cols + 63) / 64;
+    g->words = calloc((size_t)g->words_per_row * rows * depth, sizeof(uint64_t));
+    // one slab per pool thread: each slab recomputes two boundary plane sums
+    int threads = parallel_thread_count();
+    g->n_slabs = threads < depth ? threads : depth;
+    g->slab_size = (3 * PLANE_BITS + 2) * (size_t)rows * g->words_per_row;
+    g->slab_buffers = malloc((size_t)g->n_slabs * g->slab_size * sizeof(uint64_t));
+    if (!g->words || !g->slab_buffers) {
+        life3d_grid_free(g);
+        return -1;
+    }
+    return 0;
+}
+
+void life3d_grid_free(Life3dGrid *g) {
+    free(g->words);
+    free(g->slab_buffers);
+    memset(g, 0, sizeof(*g));
+}
+
+void life3d_grid_load(Life3dGrid *g, const CellState *cells) {
+    memset(g->words, 0, (size_t)g->words_per_row * g->rows * g->depth * sizeof(uint64_t));
+    for (int z = 0; z < g->depth; z++) {
+        for (int y = 0; y < g->rows; y++) {
+            uint64_t *row = row_ptr(g, y, z);
+            const CellState *src = cells + life3d_index(0, y, z, g->cols, g->rows, g->depth);
+            for (int x = 0; x < g->cols; x++)
+                row[x / 64] |= (uint64_t)(src[x] == ALIVE) << (x % 64);
+        }
+    }
+}
+
+void life3d_grid_store(const Life3dGrid *g, CellState *cells) {
+    for (int z = 0; z < g->depth; z++) {
+        for (int y = 0; y < g->rows; y++) {
+            const uint64_t *row = row_ptr(g, y, z);
+            CellState *dst = cells + life3d_index(0, y, z, g->cols, g->rows, g->depth);
+            for (int x = 0; x < g->cols; x++)
+                dst[x] = (row[x / 64] >> (x % 64)) & 1 ? ALIVE : DEAD;
+        }
+    }
+}
+
+static uint64_t *voxel_word(const Life3dGrid *g, int *x, int y, int z) {
+    *x = (*x % g->cols + g->cols) % g->cols;
+    y = (y % g->rows + g->rows) % g->rows;
+    z = (z % g->depth + g->depth) % g->depth;
+    return &row_ptr(g, y, z)[*x / 64];
+}
+
+CellState life3d_get(const Life3dGrid *g, int x, int y, int z) {
+    uint64_t word = *voxel_word(g, &x, y, z);
+    return (word >> (x % 64)) & 1 ? ALIVE : DEAD;
+}
+
+void life3d_set(Life3dGrid *g, int x, int y, int z, CellState state) {
+    uint64_t *word = voxel_word(g, &x, y, z);
+    uint64_t bit = 1ULL << (x % 64);
+    *word = state == ALIVE ? *word | bit : *word & ~bit;
+}
+
+long life3d_population(const Life3dGrid *g) {
+    long n = 0;
+    size_t total = (size_t)g->words_per_row * g->rows * g->depth;
+    for (size_t i = 0; i < total; i++)
+        n += __builtin_popcountll(g->words[i]);
+    return n;
+}
+
+// Word w with every voxel replaced by its x - 1 / x + 1 neighbor (as bitgrid.c).
+static uint64_t shift_west(const uint64_t *row, int w, int last, int tail) {
+    uint64_t carry = w ? row[w - 1] >> 63 : (row[last] >> (tail - 1)) & 1;
+    return (row[w] << 1) | carry;
+}
+
+static uint64_t shift_east(const uint64_t *row, int w, int last, int tail) {
+    uint64_t carry = w < last ? row[w + 1] << 63 : (row[0] & 1) << (tail - 1);
+    return (row[w] >> 1) | carry;
+}
+
+// Bitsliced per-plane sums. A plane sum holds, for every voxel of plane z, the
+// 3x3 sum over (x +- 1, y +- 1) as 4 bit-planes; consecutive output planes
+// share two of their three input plane sums, and each row's 3-wide x sum is
+// shared by three plane-sum rows.
+typedef struct {
+    const Life3dGrid *curr;
+    Life3dGrid *next;
+    const Life3dRule *rule;
+} StepJob;
+
+static void plane_sum(const Life3dGrid *g, int z, uint64_t *sum, uint64_t *row_sums) {
+    int wpr = g->words_per_row, last = wpr - 1, rows = g->rows;
+    int tail = g->cols % 64 ? g->cols % 64 : 64;
+    size_t plane = (size_t)rows * wpr;
+
+    // row_sums: bit-planes h0, h1 of west + center + east
+    for (int y = 0; y < rows; y++) {
+        const uint64_t *row = row_ptr(g, y, z);
+        uint64_t *h0 = row_sums + (size_t)y * wpr, *h1 = h0 + plane;
+        for (int w = 0; w < wpr; w++)
+            bs_full_add(shift_west(row, w, last, tail), row[w], shift_east(row, w, last, tail), &h0[w], &h1[w]);
+    }
+
+    for (int y = 0; y < rows; y++) {
+        size_t up = (size_t)(y == 0 ? rows - 1 : y - 1) * wpr;
+        size_t mid = (size_t)y * wpr;
+        size_t down = (size_t)(y == rows - 1 ? 0 : y + 1) * wpr;
+        const uint64_t *h0 = row_sums, *h1 = row_sums + plane;
+        uint64_t *s = sum + mid;
+        for (int w = 0; w < wpr; w++) {
+            uint64_t s0, k0, t, k1, s1, k2;
+            bs_full_add(h0[up + w], h0[mid + w], h0[down + w], &s0, &k0);
+            bs_full_add(h1[up + w], h1[mid + w], h1[down + w], &t, &k1);
+            bs_half_add(t, k0, &s1, &k2);
+            s[w] = s0;
+            s[plane + w] = s1;
+            bs_half_add(k1, k2, &s[2 * plane + w], &s[3 * plane + w]);
+        }
+    }
+}
+
+// Next state from the alive word and the 5-bit count of the 27-voxel block.
+static uint64_t apply_rule(const Life3dRule *rule, uint64_t alive, const uint64_t t[5]) {
+    uint64_t result = 0;
+    for (int v = 0; v <= LIFE3D_MAX_NEIGHBORS + 1; v++) {
+        uint64_t from_dead = v <= LIFE3D_MAX_NEIGHBORS && ((rule->birth >> v) & 1) ? ~alive : 0;
+        uint64_t from_alive = v >= 1 && ((rule->survive >> (v - 1)) & 1) ? alive : 0;
+        if (!(from_dead | from_alive))
+            continue;
+        uint64_t eq = from_dead | from_alive;
+        for (int b = 0; b < 5; b++)
+            eq &= (v >> b) & 1 ? t[b] : ~t[b];
+        result |= eq;
+    }
+    return result;
+}
+
+// One Z-slab: plane sums rotate through three slots as z advances.
+static void step_slab(const StepJob *job, int z_begin, int z_end, uint64_t *buf) {
+    const Life3dGrid *g = job->curr;
+    int wpr = g->words_per_row, depth = g->depth;
+    size_t plane = (size_t)g->rows * wpr;
+    uint64_t tail_mask = g->cols % 64 ? (1ULL << (g->cols % 64)) - 1 : ~0ULL;
+
+    uint64_t *slots[3] = {buf, buf + PLANE_BITS * plane, buf + 2 * PLANE_BITS * plane};
+    uint64_t *row_sums = buf + 3 * PLANE_BITS * plane;
+
+    plane_sum(g, (z_begin - 1 + depth) % depth, slots[0], row_sums);
+    plane_sum(g, z_begin, slots[1], row_sums);
+    for (int z = z_begin; z < z_end; z++) {
+        const uint64_t *below = slots[(z - z_begin) % 3];
+        const uint64_t *here = slots[(z - z_begin + 1) % 3];
+        uint64_t *above = slots[(z - z_begin + 2) % 3];
+        plane_sum(g, (z + 1) % depth, above, row_sums);
+
+        for (size_t i = 0; i < plane; i++) {
+            uint64_t t[5], c, c2;
+            // below + here, then + above; the largest total is 27
+            bs_half_add(below[i], here[i], &t[0], &c);
+            bs_full_add(below[plane + i], here[plane + i], c, &t[1], &c);
+            bs_full_add(below[2 * plane + i], here[2 * plane + i], c, &t[2], &c);
+            bs_full_add(below[3 * plane + i], here[3 * plane + i], c, &t[3], &t[4]);
+            bs_half_add(t[0], above[i], &t[0], &c);
+            bs_full_add(t[1], above[plane + i], c, &t[1], &c);
+            bs_full_add(t[2], above[2 * plane + i], c, &t[2], &c);
+            bs_full_add(t[3], above[3 * plane + i], c, &t[3], &c2);
+            t[4] ^= c2;
+
+            int y = (int)(i / wpr), w = (int)(i % wpr);
+            uint64_t out = apply_rule(job->rule, row_ptr(g, y, z)[w], t);
+            row_ptr(job->next, y, z)[w] = w == wpr - 1 ? out & tail_mask : out;
+        }
+    }
+}
+
+// Slab s owns planes [depth * s / n_slabs, depth * (s + 1) / n_slabs) and its
+// own buffer from next, so stepping allocates nothing.
+static void run_slabs(int begin, int end, void *ctx) {
+    const StepJob *job = ctx;
+    const Life3dGrid *next = job->next;
+    for (int s = begin; s < end; s++) {
+        int lo = (int)((long long)next->depth * s / next->n_slabs);
+        int hi = (int)((long long)next->depth * (s + 1) / next->n_slabs);
+        if (lo < hi)
+            step_slab(job, lo, hi, next->slab_buffers + (size_t)s * next->slab_size);
+    }
+}
+
+// curr and next must be distinct grids of the same size.
+void life3d_step(const Life3dGrid *curr, Life3dGrid *next, const Life3dRule *rule) {
+    StepJob job = {curr, next, rule};
+    parallel_for(0, next->n_slabs, run_slabs, &job);
+}
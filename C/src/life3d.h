@@ -0,0 +1,42 @@
+#ifndef LIFE3D_H
+#define LIFE3D_H
+
+#include <stdint.h>
+#include "game_core.h"
+
+#define LIFE3D_MAX_NEIGHBORS 26
+
+// Outer-totalistic rule over the 26-cell Moore neighborhood.
+typedef struct {
+    uint32_t birth;    // bit n set: a dead voxel with n alive neighbors is born
+    uint32_t survive;  // bit n set: an alive voxel with n alive neighbors survives
+} Life3dRule;
+
+// Toroidal cols x rows x depth volume packed one voxel per bit along x; each
+// row starts on a fresh word and padding bits are kept zero.
+typedef struct {
+    int cols;
+    int rows;
+    int depth;
+    int words_per_row;
+    uint64_t *words;
+    int n_slabs;              // Z slabs stepped in parallel, fixed at init
+    size_t slab_size;         // plane sums plus row sums, in words
+    uint64_t *slab_buffers;   // n_slabs x slab_size, used when this is next
+} Life3dGrid;
+
+extern const Life3dRule LIFE3D_RULE_4555;
+
+int life3d_rule_parse(Life3dRule *rule, const char *rulestring);
+int life3d_index(int x, int y, int z, int cols, int rows, int depth);
+
+int life3d_grid_init(Life3dGrid *g, int cols, int rows, int depth);
+void life3d_grid_free(Life3dGrid *g);
+void life3d_grid_load(Life3dGrid *g, const CellState *cells);
+void life3d_grid_store(const Life3dGrid *g, CellState *cells);
+CellState life3d_get(const Life3dGrid *g, int x, int y, int z);
+void life3d_set(Life3dGrid *g, int x, int y, int z, CellState state);
+long life3d_population(const Life3dGrid *g);
+void life3d_step(const Life3dGrid *curr, Life3dGrid *next, const Life3dRule *rule);
+
+#endif
@@ -0,0 +1,84 @@
+#include "life_rule.h"
+#include <ctype.h>
+#include <stdio.h>
+
+const LifeRule LIFE_RULE_CONWAY = {
+    .birth = 1u << 3,
+    .survive = (1u << 2) | (1u << 3),
+    .table = {0, 0, 0, 1, 0, 0, 0, 0, 0,
+              0, 0, 1, 1, 0, 0, 0, 0, 0},
+};
+
+void life_rule_from_masks(LifeRule *rule, uint16_t birth, uint16_t survive) {
+    rule->birth = birth & 0x1ff;
+    rule->survive = survive & 0x1ff;
+    for (int n = 0; n <= LIFE_RULE_MAX_NEIGHBORS; n++) {
+        rule->table[LIFE_RULE_INDEX(0, n)] = (rule->birth >> n) & 1;
+        rule->table[LIFE_RULE_INDEX(1, n)] = (rule->survive >> n) & 1;
+    }
+}
+
+// Reads a run of neighbor counts into a bit mask; returns the first unread char.
+// Shared by the B/S parsers of the rule families built on Moore counts.
+const char *life_rule_parse_counts(const char *s, uint16_t *mask) {
+    *mask = 0;
+    while (*s >= '0' && *s <= '8') {
+        *mask |= 1u << (*s - '0');
+        s++;
+    }
+    return s;
+}
+
+// Accepts "B3/S23", "S23/B3", "B3S23" (any case) and the legacy survive/birth form "23/3".
+int life_rule_parse(LifeRule *rule, const char *rulestring) {
+    uint16_t birth = 0, survive = 0;
+    int seen_birth = 0, seen_survive = 0;
+    const char *s = rulestring;
+
+    if (isdigit((unsigned char)*s) || (*s == '/' && isdigit((unsigned char)s[1]))) {
+        s = life_rule_parse_counts(s, &survive);
+        if (*s++ != '/')
+            return -1;
+        s = life_rule_parse_counts(s, &birth);
+        if (*s != '\0')
+            return -1;
+        life_rule_from_masks(rule, birth, survive);
+        return 0;
+    }
+
+    while (*s) {
+        char c = (char)toupper((unsigned char)*s++);
+        if (c == 'B' && !seen_birth) {
+            s = life_rule_parse_counts(s, &birth);
+            seen_birth = 1;
+        } else if (c == 'S' && !seen_survive) {
+            s = life_rule_parse_counts(s, &survive);
+            seen_survive = 1;
+        } else {
+            return -1;
+        }
+        // A slash must separate two lists; a trailing one is leftover input
+        if (*s == '/' && *++s == '\0')
+            return -1;
+    }
+    if (!seen_birth || !seen_survive)
+        return -1;
+
+    life_rule_from_masks(rule, birth, survive);
+    return 0;
+}
+
+void life_rule_format(const LifeRule *rule, char *buf, size_t len) {
+    char digits[2][LIFE_RULE_MAX_NEIGHBORS + 2];
+    uint16_t masks[2] = {rule->birth, rule->survive};
+
+    for (int i = 0; i < 2; i++) {
+        int k = 0;
+        for (int n = 0; n <= LIFE_RULE_MAX_NEIGHBORS; n++) {
+            if ((masks[i] >> n) & 1)
+                digits[i][k++] = (char)('0' + n);
+        }
+        digits[i][k] = '\0';
+    }
+    snprintf(buf, len, "B%s/S%s", digits[0], digits[1]);
+}
@@ -0,0 +1,25 @@
+#ifndef LIFE_RULE_H
+#define LIFE_RULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LIFE_RULE_MAX_NEIGHBORS 8
+#define LIFE_RULE_TABLE_SIZE (2 * (LIFE_RULE_MAX_NEIGHBORS + 1))
+#define LIFE_RULE_INDEX(state, count) ((state) * (LIFE_RULE_MAX_NEIGHBORS + 1) + (count))
+
+// Outer-totalistic two-state rule, compiled from a rulestring such as "B36/S23".
+typedef struct {
+    uint16_t birth;    // bit n set: a dead cell with n alive neighbors is born
+    uint16_t survive;  // bit n set: an alive cell with n alive neighbors survives
+    uint8_t table[LIFE_RULE_TABLE_SIZE];  // next state, indexed by LIFE_RULE_INDEX
+} LifeRule;
+
+extern const LifeRule LIFE_RULE_CONWAY;
+
+const char *life_rule_parse_counts(const char *s, uint16_t *mask);
+int life_rule_parse(LifeRule *rule, const char *rulestring);
+void life_rule_from_masks(LifeRule *rule, uint16_t birth, uint16_t survive);
+void life_rule_format(const LifeRule *rule, char *buf, size_t len);
+
+#endif
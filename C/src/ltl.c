@@ -0,0 +1,306 @@
+#include "ltl.h"
+#include "parallel.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LTL_MAX_INTERVALS 64
+
+typedef struct {
+    int lo[LTL_MAX_INTERVALS];
+    int hi[LTL_MAX_INTERVALS];
+    int n;
+} CountSet;
+
+static int neighborhood_size(int range, LtlNeighborhood neighborhood) {
+    return neighborhood == LTL_MOORE ? (2 * range + 1) * (2 * range + 1) : 2 * range * (range + 1) + 1;
+}
+
+// Parses "34..58", "34-58" or "34" into an interval.
+static int parse_interval(const char *s, CountSet *set) {
+    char *end;
+    long lo = strtol(s, &end, 10), hi = lo;
+    if (end == s || set->n == LTL_MAX_INTERVALS)
+        return -1;
+    if (end[0] == '.' && end[1] == '.')
+        end += 2;
+    else if (end[0] == '-')
+        end++;
+    if (end != s && *end) {
+        const char *start = end;
+        hi = strtol(start, &end, 10);
+        if (end == start || *end)
+            return -1;
+    }
+    if (lo < 0 || hi < lo)
+        return -1;
+    set->lo[set->n] = (int)lo;
+    set->hi[set->n] = (int)hi;
+    set->n++;
+    return 0;
+}
+
+static uint8_t *expand(const CountSet *set, int max_count) {
+    uint8_t *table = calloc(max_count + 1, 1);
+    if (!table)
+        return NULL;
+    for (int i = 0; i < set->n; i++) {
+        for (int c = set->lo[i]; c <= set->hi[i] && c <= max_count; c++)
+            table[c] = 1;
+    }
+    return table;
+}
+
+// Comma-separated fields R<range>, C<states>, M<0|1>, S<counts>, B<counts>,
+// N<M|N>; S and B take intervals, and bare intervals extend the last of them.
+int ltl_rule_parse(LtlRule *rule, const char *rulestring) {
+    CountSet birth = {.n = 0}, survive = {.n = 0};
+    CountSet *current = NULL;
+    char buf[512];
+    memset(rule, 0, sizeof(*rule));
+    rule->range = -1;
+    rule->include_center = 1;
+
+    if (strlen(rulestring) >= sizeof(buf))
+        return -1;
+    strcpy(buf, rulestring);
+
+    for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+        char field = (char)toupper((unsigned char)tok[0]);
+        if (isdigit((unsigned char)field)) {
+            if (!current || parse_interval(tok, current) != 0)
+                return -1;
+            continue;
+        }
+        current = NULL;
+        char *end;
+        switch (field) {
+        case 'R':
+            rule->range = (int)strtol(tok + 1, &end, 10);
+            if (end == tok + 1 || *end || rule->range < 1 || rule->range > LTL_MAX_RANGE)
+                return -1;
+            break;
+        case 'C': {
+            long states = strtol(tok + 1, &end, 10);
+            // Only two-state rules; C0 and C2 both mean that
+            if (end == tok + 1 || *end || (states != 0 && states != 2))
+                return -1;
+            break;
+        }
+        case 'M':
+            if ((tok[1] != '0' && tok[1] != '1') || tok[2])
+                return -1;
+            rule->include_center = tok[1] == '1';
+            break;
+        case 'S':
+        case 'B':
+            current = field == 'S' ? &survive : &birth;
+            if (tok[1] && parse_interval(tok + 1, current) != 0)
+                return -1;
+            break;
+        case 'N': {
+            char kind = (char)toupper((unsigned char)tok[1]);
+            if ((kind != 'M' && kind != 'N') || tok[2])
+                return -1;
+            rule->neighborhood = kind == 'M' ? LTL_MOORE : LTL_VON_NEUMANN;
+            break;
+        }
+        default:
+            return -1;
+        }
+    }
+    if (rule->range < 1)
+        return -1;
+
+    rule->max_count = neighborhood_size(rule->range, rule->neighborhood);
+    rule->birth = expand(&birth, rule->max_count);
+    rule->survive = expand(&survive, rule->max_count);
+    if (!rule->birth || !rule->survive) {
+        ltl_rule_free(rule);
+        return -1;
+    }
+    return 0;
+}
+
+void ltl_rule_free(LtlRule *rule) {
+    free(rule->birth);
+    free(rule->survive);
+    rule->birth = rule->survive = NULL;
+}
+
+static size_t sat_index(const LtlEngine *e, int i, int j) {
+    return (size_t)j * (e->width + 1) + i;
+}
+
+// Diagonal tables carry a zero border, so i and j may be -1 or width/height.
+static size_t diag_index(const LtlEngine *e, int i, int j) {
+    return (size_t)(j + 1) * (e->width + 2) + (i + 1);
+}
+
+int ltl_engine_init(LtlEngine *engine, int cols, int rows, const LtlRule *rule) {
+    memset(engine, 0, sizeof(*engine));
+    if (cols < 1 || rows < 1)
+        return -1;
+    engine->cols = cols;
+    engine->rows = rows;
+    engine->width = cols + 2 * rule->range;
+    engine->height = rows + 2 * rule->range;
+    engine->rule = *rule;
+    engine->rule.birth = malloc(rule->max_count + 1);
+    engine->rule.survive = malloc(rule->max_count + 1);
+
+    if (rule->neighborhood == LTL_MOORE) {
+        engine->table = calloc((size_t)(engine->width + 1) * (engine->height + 1), sizeof(uint32_t));
+    } else {
+        size_t n = (size_t)(engine->width + 2) * (engine->height + 2);
+        engine->table = calloc(n, sizeof(uint32_t));
+        engine->anti_table = calloc(n, sizeof(uint32_t));
+    }
+    if (!engine->rule.birth || !engine->rule.survive || !engine->table ||
+        (rule->neighborhood == LTL_VON_NEUMANN && !engine->anti_table)) {
+        ltl_engine_free(engine);
+        return -1;
+    }
+    memcpy(engine->rule.birth, rule->birth, rule->max_count + 1);
+    memcpy(engine->rule.survive, rule->survive, rule->max_count + 1);
+    return 0;
+}
+
+void ltl_engine_free(LtlEngine *engine) {
+    ltl_rule_free(&engine->rule);
+    free(engine->table);
+    free(engine->anti_table);
+    memset(engine, 0, sizeof(*engine));
+}
+
+typedef struct {
+    LtlEngine *engine;
+    const CellState *curr;
+    CellState *next;
+} StepJob;
+
+// Cell of the padded grid; padded (i, j) is grid (i - range, j - range) wrapped.
+static int padded_cell(const LtlEngine *e, const CellState *grid, int i, int j) {
+    int r = e->rule.range;
+    int x = ((i - r) % e->cols + e->cols) % e->cols;
+    int y = ((j - r) % e->rows + e->rows) % e->rows;
+    return grid[(size_t)y * e->cols + x] == ALIVE;
+}
+
+static void sat_rows(int begin, int end, void *ctx) {
+    StepJob *job = ctx;
+    LtlEngine *e = job->engine;
+    for (int j = begin; j < end; j++) {
+        int r = e->rule.range;
+        const CellState *src = job->curr + (size_t)(((j - r) % e->rows + e->rows) % e->rows) * e->cols;
+        int x = ((-r) % e->cols + e->cols) % e->cols;
+        uint32_t *row = e->table + sat_index(e, 0, j + 1);
+        uint32_t sum = 0;
+        for (int i = 0; i < e->width; i++) {
+            sum += src[x] == ALIVE;
+            row[i + 1] = sum;
+            if (++x == e->cols)
+                x = 0;
+        }
+    }
+}
+
+static void sat_columns(int begin, int end, void *ctx) {
+    LtlEngine *e = ((StepJob *)ctx)->engine;
+    for (int j = 2; j <= e->height; j++) {
+        uint32_t *row = e->table + sat_index(e, 0, j);
+        const uint32_t *above = row - (e->width + 1);
+        for (int i = begin; i < end; i++)
+            row[i] += above[i];
+    }
+}
+
+// Walks one diagonal (down-right) and one anti-diagonal (up-right) per index.
+static void diagonal_prefixes(int begin, int end, void *ctx) {
+    StepJob *job = ctx;
+    LtlEngine *e = job->engine;
+    int w = e->width, h = e->height;
+    for (int k = begin; k < end; k++) {
+        int i = k < w ? k : 0, j = k < w ? 0 : k - w + 1;
+        for (; i < w && j < h; i++, j++)
+            e->table[diag_index(e, i, j)] = padded_cell(e, job->curr, i, j) + e->table[diag_index(e, i - 1, j - 1)];
+
+        i = k < h ? 0 : k - h + 1;
+        j = k - i;
+        for (; i < w && j >= 0; i++, j--)
+            e->anti_table[diag_index(e, i, j)] = padded_cell(e, job->curr, i, j) + e->anti_table[diag_index(e, i - 1, j + 1)];
+    }
+}
+
+static uint32_t box_count(const LtlEngine *e, int x, int y) {
+    int span = 2 * e->rule.range + 1;
+    return e->table[sat_index(e, x + span, y + span)] - e->table[sat_index(e, x, y + span)] -
+           e->table[sat_index(e, x + span, y)] + e->table[sat_index(e, x, y)];
+}
+
+// Sum along the down-right diagonal from (i, j) over k + 1 cells.
+static uint32_t down_diagonal(const LtlEngine *e, int i, int j, int k) {
+    return e->table[diag_index(e, i + k, j + k)] - e->table[diag_index(e, i - 1, j - 1)];
+}
+
+// Sum along the up-right diagonal from (i, j) over k + 1 cells.
+static uint32_t up_diagonal(const LtlEngine *e, int i, int j, int k) {
+    return e->anti_table[diag_index(e, i + k, j - k)] - e->anti_table[diag_index(e, i - 1, j + 1)];
+}
+
+static uint32_t diamond_direct(const LtlEngine *e, const CellState *grid, int cx, int cy) {
+    int r = e->rule.range;
+    uint32_t sum = 0;
+    for (int dy = -r; dy <= r; dy++) {
+        int reach = r - abs(dy);
+        for (int dx = -reach; dx <= reach; dx++)
+            sum += padded_cell(e, grid, cx + dx, cy + dy);
+    }
+    return sum;
+}
+
+static CellState apply_rule(const LtlRule *rule, CellState state, uint32_t count) {
+    if (!rule->include_center)
+        count -= state == ALIVE;
+    return (state == ALIVE ? rule->survive : rule->birth)[count] ? ALIVE : DEAD;
+}
+
+static void evaluate_rows(int begin, int end, void *ctx) {
+    StepJob *job = ctx;
+    const LtlEngine *e = job->engine;
+    int r = e->rule.range;
+
+    for (int y = begin; y < end; y++) {
+        const CellState *in = job->curr + (size_t)y * e->cols;
+        CellState *out = job->next + (size_t)y * e->cols;
+        if (e->rule.neighborhood == LTL_MOORE) {
+            for (int x = 0; x < e->cols; x++)
+                out[x] = apply_rule(&e->rule, in[x], box_count(e, x, y));
+            continue;
+        }
+
+        // Slide the diamond right: add the new right edge, drop the old left edge
+        int cy = y + r;
+        uint32_t count = diamond_direct(e, job->curr, r, cy);
+        out[0] = apply_rule(&e->rule, in[0], count);
+        for (int x = 1; x < e->cols; x++) {
+            int cx = x - 1 + r;
+            count += down_diagonal(e, cx + 1, cy - r, r) + up_diagonal(e, cx + 1, cy + r, r) -
+                     padded_cell(e, job->curr, cx + 1 + r, cy);
+            count -= up_diagonal(e, cx - r, cy, r) + down_diagonal(e, cx - r, cy, r) -
+                     padded_cell(e, job->curr, cx - r, cy);
+            out[x] = apply_rule(&e->rule, in[x], count);
+        }
+    }
+}
+
+void ltl_engine_step(LtlEngine *engine, const CellState *curr_grid, CellState *next_grid) {
+    StepJob job = {engine, curr_grid, next_grid};
+    if (engine->rule.neighborhood == LTL_MOORE) {
+        parallel_for(0, engine->height, sat_rows, &job);
+        parallel_for(1, engine->width + 1, sat_columns, &job);
+    } else {
+        parallel_for(0, engine->width + engine->height - 1, diagonal_prefixes, &job);
+    }
+    parallel_for(0, engine->rows, evaluate_rows, &job);
+}
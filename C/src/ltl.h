@@ -0,0 +1,39 @@
+#ifndef LTL_H
+#define LTL_H
+
+#include <stdint.h>
+#include "game_core.h"
+
+#define LTL_MAX_RANGE 100
+
+typedef enum { LTL_MOORE = 0, LTL_VON_NEUMANN = 1 } LtlNeighborhood;
+
+// Larger than Life rule, e.g. "R5,C0,M1,S34..58,B34..45,NM" (Bosco's rule).
+typedef struct {
+    int range;
+    int include_center;        // M1: the cell counts itself
+    LtlNeighborhood neighborhood;
+    int max_count;             // cells in the neighborhood, center included
+    uint8_t *birth;            // indexed by count, max_count + 1 entries
+    uint8_t *survive;
+} LtlRule;
+
+// Step engine with per-generation prefix tables over the grid padded by
+// `range` wrapped cells on every side, so each neighborhood count is O(1).
+typedef struct {
+    int cols;
+    int rows;
+    int width;                 // cols + 2 * range
+    int height;                // rows + 2 * range
+    LtlRule rule;
+    uint32_t *table;           // summed-area table (Moore) or ...
+    uint32_t *anti_table;      // ... the two diagonal prefix tables (von Neumann)
+} LtlEngine;
+
+int ltl_rule_parse(LtlRule *rule, const char *rulestring);
+void ltl_rule_free(LtlRule *rule);
+int ltl_engine_init(LtlEngine *engine, int cols, int rows, const LtlRule *rule);
+void ltl_engine_free(LtlEngine *engine);
+void ltl_engine_step(LtlEngine *engine, const CellState *curr_grid, CellState *next_grid);
+
+#endif
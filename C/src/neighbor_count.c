@@ -0,0 +1,45 @@
+#include "neighbor_count.h"
+
+// Columns summed per pass; the partial sums live on the stack.
+#define SPAN_CHUNK 256
+
+// Counts for w cells of one row starting at column x0 (already wrapped).
+// Vertical 3-cell sums are formed once per column and reused by the three
+// cells they touch; inner loops run over contiguous columns and vectorize.
+static void count_span(const CellState *up, const CellState *mid, const CellState *down,
+                       int cols, int x0, int w, uint8_t *out) {
+    uint8_t column[SPAN_CHUNK + 2], center[SPAN_CHUNK + 2];
+    for (int start = 0; start < w; start += SPAN_CHUNK) {
+        int n = w - start < SPAN_CHUNK ? w - start : SPAN_CHUNK;
+        int x = ((x0 + start - 1) % cols + cols) % cols;
+        for (int i = 0; i < n + 2; x = 0) {
+            int run = n + 2 - i < cols - x ? n + 2 - i : cols - x;
+            for (int k = 0; k < run; k++) {
+                column[i + k] = (uint8_t)(up[x + k] + mid[x + k] + down[x + k]);
+                center[i + k] = (uint8_t)mid[x + k];
+            }
+            i += run;
+        }
+        for (int i = 0; i < n; i++)
+            out[start + i] = (uint8_t)(column[i] + column[i + 1] + column[i + 2] - center[i + 1]);
+    }
+}
+
+int neighbor_count_rect(const CellState *grid, int cols, int rows, int x, int y, int w, int h,
+                        uint8_t *counts, int stride) {
+    if (w < 0 || h < 0 || w > cols || h > rows)
+        return -1;
+    x = (x % cols + cols) % cols;
+    for (int r = 0; r < h; r++) {
+        int row = ((y + r) % rows + rows) % rows;
+        const CellState *mid = grid + (size_t)row * cols;
+        const CellState *up = grid + (size_t)(row == 0 ? rows - 1 : row - 1) * cols;
+        const CellState *down = grid + (size_t)(row == rows - 1 ? 0 : row + 1) * cols;
+        count_span(up, mid, down, cols, x, w, counts + (size_t)r * stride);
+    }
+    return 0;
+}
+
+int neighbor_count_row(const CellState *grid, int cols, int rows, int y, uint8_t *counts) {
+    return neighbor_count_rect(grid, cols, rows, 0, y, cols, 1, counts, cols);
+}
@@ -0,0 +1,14 @@
+#ifndef NEIGHBOR_COUNT_H
+#define NEIGHBOR_COUNT_H
+
+#include <stdint.h>
+#include "game_core.h"
+
+// Batched get_alive_neighbors: Moore neighbor counts for a row or a
+// rectangle of a toroidal cols x rows grid, written to a caller array.
+// Coordinates wrap like pos_to_index; w and h may not exceed the grid.
+int neighbor_count_row(const CellState *grid, int cols, int rows, int y, uint8_t *counts);
+int neighbor_count_rect(const CellState *grid, int cols, int rows, int x, int y, int w, int h,
+                        uint8_t *counts, int stride);
+
+#endif
@@ -0,0 +1,219 @@
+#include "parallel.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define PARALLEL_MAX_THREADS 256
+// Chunks per thread, so uneven rows still balance out
+#define PARALLEL_CHUNKS_PER_THREAD 4
+
+typedef struct {
+    ParallelFn fn;
+    void *ctx;
+    int end;
+    int chunk;
+    atomic_int next;
+} Job;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t submit_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t work_done = PTHREAD_COND_INITIALIZER;
+static pthread_t workers[PARALLEL_MAX_THREADS];
+static int n_workers = 0;      // helper threads; the caller is one more
+static atomic_int requested_threads = 0;  // written under submit_lock, read anywhere
+static int shutting_down = 0;
+static unsigned long job_serial = 0;
+static Job *current_job = NULL;
+static int busy_workers = 0;  // workers holding a pointer to current_job
+static _Thread_local int inside_pool = 0;
+
+// Submitted tasks run in FIFO order on one extra thread, which is not a pool
+// member, so their parallel_for calls still fan out over the workers.
+static pthread_mutex_t async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_ready = PTHREAD_COND_INITIALIZER;
+static pthread_t async_thread;
+static int async_started = 0;
+static int async_stopping = 0;
+static ParallelTask *async_head = NULL;
+static ParallelTask *async_tail = NULL;
+
+// Claims and runs chunks until none are left to claim.
+static void run_chunks(Job *job) {
+    for (;;) {
+        int lo = atomic_fetch_add(&job->next, job->chunk);
+        if (lo >= job->end)
+            return;
+        int hi = lo + job->chunk < job->end ? lo + job->chunk : job->end;
+        job->fn(lo, hi, job->ctx);
+    }
+}
+
+static void *worker_main(void *arg) {
+    (void)arg;
+    unsigned long seen = 0;
+    inside_pool = 1;
+    pthread_mutex_lock(&pool_lock);
+    for (;;) {
+        while (!shutting_down && (current_job == NULL || job_serial == seen))
+            pthread_cond_wait(&work_ready, &pool_lock);
+        if (shutting_down)
+            break;
+        Job *job = current_job;
+        seen = job_serial;
+        busy_workers++;
+        pthread_mutex_unlock(&pool_lock);
+        run_chunks(job);
+        pthread_mutex_lock(&pool_lock);
+        if (--busy_workers == 0)
+            pthread_cond_broadcast(&work_done);
+    }
+    pthread_mutex_unlock(&pool_lock);
+    return NULL;
+}
+
+static void *async_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&async_lock);
+    for (;;) {
+        while (!async_head && !async_stopping)
+            pthread_cond_wait(&async_ready, &async_lock);
+        ParallelTask *task = async_head;
+        if (!task)
+            break;
+        async_head = task->next;
+        if (!async_head)
+            async_tail = NULL;
+        pthread_mutex_unlock(&async_lock);
+        task->fn(task->ctx);
+        pthread_mutex_lock(&async_lock);
+    }
+    pthread_mutex_unlock(&async_lock);
+    return NULL;
+}
+
+// Runs the queued tasks to completion, then stops the task thread.
+static void stop_async(void) {
+    pthread_mutex_lock(&async_lock);
+    int started = async_started;
+    async_stopping = 1;
+    pthread_cond_broadcast(&async_ready);
+    pthread_mutex_unlock(&async_lock);
+    if (started)
+        pthread_join(async_thread, NULL);
+    pthread_mutex_lock(&async_lock);
+    async_started = 0;
+    async_stopping = 0;
+    pthread_mutex_unlock(&async_lock);
+}
+
+static int default_thread_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n < 1 ? 1 : n > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : (int)n;
+}
+
+// Called with pool_lock held.
+static void start_workers(void) {
+    int total = parallel_thread_count();
+    if (total > PARALLEL_MAX_THREADS)
+        total = PARALLEL_MAX_THREADS;
+    shutting_down = 0;
+    for (n_workers = 0; n_workers < total - 1; n_workers++) {
+        if (pthread_create(&workers[n_workers], NULL, worker_main, NULL) != 0)
+            break;
+    }
+}
+
+static void stop_workers(void) {
+    pthread_mutex_lock(&pool_lock);
+    shutting_down = 1;
+    pthread_cond_broadcast(&work_ready);
+    int n = n_workers;
+    n_workers = 0;
+    pthread_mutex_unlock(&pool_lock);
+    for (int i = 0; i < n; i++)
+        pthread_join(workers[i], NULL);
+}
+
+// Lock-free, so it is safe from inside a running parallel_for.
+int parallel_thread_count(void) {
+    int requested = atomic_load_explicit(&requested_threads, memory_order_relaxed);
+    return requested > 0 ? requested : default_thread_count();
+}
+
+// 0 selects one thread per online CPU. Takes effect on the next parallel_for.
+void parallel_set_thread_count(int n_threads) {
+    pthread_mutex_lock(&submit_lock);
+    stop_workers();
+    atomic_store_explicit(&requested_threads, n_threads < 0 ? 0 : n_threads, memory_order_relaxed);
+    pthread_mutex_unlock(&submit_lock);
+}
+
+// Submitted tasks may call parallel_for, so they are drained first.
+void parallel_shutdown(void) {
+    stop_async();
+    pthread_mutex_lock(&submit_lock);
+    stop_workers();
+    pthread_mutex_unlock(&submit_lock);
+}
+
+// Runs fn over [begin, end) split into chunks, on the pool plus the calling
+// thread, and returns when every chunk is done. Calls made from inside a
+// pool task run inline.
+void parallel_for(int begin, int end, ParallelFn fn, void *ctx) {
+    if (end <= begin)
+        return;
+    if (inside_pool || parallel_thread_count() == 1) {
+        fn(begin, end, ctx);
+        return;
+    }
+
+    pthread_mutex_lock(&submit_lock);
+    pthread_mutex_lock(&pool_lock);
+    if (n_workers == 0)
+        start_workers();
+
+    int n_chunks = (n_workers + 1) * PARALLEL_CHUNKS_PER_THREAD;
+    Job job = {.fn = fn, .ctx = ctx, .end = end};
+    job.chunk = (end - begin + n_chunks - 1) / n_chunks;
+    atomic_init(&job.next, begin);
+    current_job = &job;
+    job_serial++;
+    pthread_cond_broadcast(&work_ready);
+    pthread_mutex_unlock(&pool_lock);
+
+    inside_pool = 1;
+    run_chunks(&job);
+    inside_pool = 0;
+
+    // Every chunk is claimed now; wait for the workers still running one.
+    pthread_mutex_lock(&pool_lock);
+    while (busy_workers > 0)
+        pthread_cond_wait(&work_done, &pool_lock);
+    current_job = NULL;
+    pthread_mutex_unlock(&pool_lock);
+    pthread_mutex_unlock(&submit_lock);
+}
+
+// Queues task->fn(task->ctx) to run off the calling thread and returns at
+// once. Returns -1 if the task thread cannot be started.
+int parallel_submit(ParallelTask *task) {
+    pthread_mutex_lock(&async_lock);
+    if (!async_started) {
+        if (pthread_create(&async_thread, NULL, async_main, NULL) != 0) {
+            pthread_mutex_unlock(&async_lock);
+            return -1;
+        }
+        async_started = 1;
+    }
+    task->next = NULL;
+    if (async_tail)
+        async_tail->next = task;
+    else
+        async_head = task;
+    async_tail = task;
+    pthread_cond_signal(&async_ready);
+    pthread_mutex_unlock(&async_lock);
+    return 0;
+}
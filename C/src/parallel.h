@@ -0,0 +1,21 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// Process-wide worker pool shared by the multi-threaded engines.
+typedef void (*ParallelFn)(int begin, int end, void *ctx);
+
+// Background task for parallel_submit. The caller owns the node and keeps it
+// alive until fn has returned; next is used by the queue.
+typedef struct ParallelTask {
+    void (*fn)(void *ctx);
+    void *ctx;
+    struct ParallelTask *next;
+} ParallelTask;
+
+void parallel_for(int begin, int end, ParallelFn fn, void *ctx);
+int parallel_submit(ParallelTask *task);
+int parallel_thread_count(void);
+void parallel_set_thread_count(int n_threads);
+void parallel_shutdown(void);
+
+#endif
@@ -0,0 +1,79 @@
+#include "random_fill.h"
+#include "parallel.h"
+#include <math.h>
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+// Cells per parallel work item; each is filled from its own counters.
+#define FILL_BATCH 4096
+
+void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+typedef struct {
+    CellState *cells;
+    size_t n_cells;
+    uint32_t key[2];
+    uint32_t threshold;
+} FillJob;
+
+// Cell i takes word i % 4 of the block with counter i / 4, so the output
+// depends only on the seed, never on how batches are spread over threads.
+static void fill_batches(int begin, int end, void *ctx) {
+    FillJob *job = ctx;
+    uint32_t r[FILL_BATCH];
+    for (int batch = begin; batch < end; batch++) {
+        size_t first = (size_t)batch * FILL_BATCH;
+        size_t n = job->n_cells - first < FILL_BATCH ? job->n_cells - first : FILL_BATCH;
+        for (size_t i = 0; i < n; i += 4) {
+            uint64_t block = (first + i) / 4;
+            uint32_t counter[4] = {(uint32_t)block, (uint32_t)(block >> 32), 0, 0};
+            philox4x32(counter, job->key, r + i);
+        }
+        // Separate compare loop so it vectorizes.
+        CellState *out = job->cells + first;
+        uint32_t threshold = job->threshold;
+        for (size_t i = 0; i < n; i++)
+            out[i] = r[i] < threshold ? ALIVE : DEAD;
+    }
+}
+
+// Each cell is alive with probability `density` (clamped to [0, 1], with
+// 2^-32 resolution). The same seed gives the same cells on any thread count.
+void random_fill(CellState *cells, size_t n_cells, double density, uint64_t seed) {
+    FillJob job = {cells, n_cells, {(uint32_t)seed, (uint32_t)(seed >> 32)}, 0};
+    if (density >= 1.0) {
+        for (size_t i = 0; i < n_cells; i++)
+            cells[i] = ALIVE;
+        return;
+    }
+    job.threshold = density > 0.0 ? (uint32_t)ldexp(density, 32) : 0;
+    parallel_for(0, (int)((n_cells + FILL_BATCH - 1) / FILL_BATCH), fill_batches, &job);
+}
+
+// Seeded, arbitrary-density counterpart of randomize_grid; it replaces every
+// cell rather than only adding alive ones.
+void randomize_grid_seeded(CellState *grid, double density, uint64_t seed) {
+    random_fill(grid, GRID_SIZE, density, seed);
+}
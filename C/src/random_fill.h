@@ -0,0 +1,15 @@
+#ifndef RANDOM_FILL_H
+#define RANDOM_FILL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "game_core.h"
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3"): four 32-bit outputs per (counter, key).
+void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+void random_fill(CellState *cells, size_t n_cells, double density, uint64_t seed);
+void randomize_grid_seeded(CellState *grid, double density, uint64_t seed);
+
+#endif
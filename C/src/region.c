@@ -0,0 +1,105 @@
+#include "region.h"
+#include <string.h>
+
+// Splits a wrapped rectangle at the grid's right and bottom edges into at
+// most four pieces; returns the count, or -1 for an invalid size.
+int region_split(int cols, int rows, int x, int y, int w, int h, RegionPiece pieces[4]) {
+    if (w < 0 || h < 0 || w > cols || h > rows)
+        return -1;
+    if (w == 0 || h == 0)
+        return 0;
+    int start = wrap_index(x, y, cols, rows);
+    x = start % cols;
+    y = start / cols;
+
+    int widths[2] = {x + w > cols ? cols - x : w, 0};
+    int heights[2] = {y + h > rows ? rows - y : h, 0};
+    widths[1] = w - widths[0];
+    heights[1] = h - heights[0];
+
+    int n = 0;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 2; i++) {
+            if (!widths[i] || !heights[j])
+                continue;
+            pieces[n++] = (RegionPiece){
+                i ? 0 : x, j ? 0 : y, widths[i], heights[j], i ? widths[0] : 0, j ? heights[0] : 0,
+            };
+        }
+    }
+    return n;
+}
+
+// Row-by-row kernel shared by every operation; the loops vectorize.
+static void blit_rows(CellState *dst, int dst_stride, const CellState *src, int src_stride,
+                      int w, int h, BlitOp op) {
+    for (int r = 0; r < h; r++) {
+        CellState *d = dst + (size_t)r * dst_stride;
+        const CellState *s = src + (size_t)r * src_stride;
+        switch (op) {
+        case BLIT_COPY: memcpy(d, s, w * sizeof(CellState)); break;
+        case BLIT_OR: for (int i = 0; i < w; i++) d[i] = (CellState)(d[i] | s[i]); break;
+        case BLIT_AND: for (int i = 0; i < w; i++) d[i] = (CellState)(d[i] & s[i]); break;
+        case BLIT_XOR: for (int i = 0; i < w; i++) d[i] = (CellState)(d[i] ^ s[i]); break;
+        }
+    }
+}
+
+int region_fill(CellState *grid, int cols, int rows, int x, int y, int w, int h, CellState state) {
+    RegionPiece pieces[4];
+    int n = region_split(cols, rows, x, y, w, h, pieces);
+    for (int p = 0; p < n; p++) {
+        for (int r = 0; r < pieces[p].h; r++) {
+            CellState *d = grid + (size_t)(pieces[p].y + r) * cols + pieces[p].x;
+            if (state == DEAD) {
+                memset(d, 0, pieces[p].w * sizeof(CellState));
+            } else {
+                for (int i = 0; i < pieces[p].w; i++)
+                    d[i] = state;
+            }
+        }
+    }
+    return n < 0 ? -1 : 0;
+}
+
+// Stamps a w x h source block (rows src_stride apart) at (x, y).
+int region_blit(CellState *grid, int cols, int rows, int x, int y,
+                const CellState *src, int w, int h, int src_stride, BlitOp op) {
+    RegionPiece pieces[4];
+    int n = region_split(cols, rows, x, y, w, h, pieces);
+    for (int p = 0; p < n; p++) {
+        const RegionPiece *q = &pieces[p];
+        blit_rows(grid + (size_t)q->y * cols + q->x, cols,
+                  src + (size_t)q->dy * src_stride + q->dx, src_stride, q->w, q->h, op);
+    }
+    return n < 0 ? -1 : 0;
+}
+
+int region_extract(const CellState *grid, int cols, int rows, int x, int y, int w, int h,
+                   CellState *dst, int dst_stride) {
+    RegionPiece pieces[4];
+    int n = region_split(cols, rows, x, y, w, h, pieces);
+    for (int p = 0; p < n; p++) {
+        const RegionPiece *q = &pieces[p];
+        blit_rows(dst + (size_t)q->dy * dst_stride + q->dx, dst_stride,
+                  grid + (size_t)q->y * cols + q->x, cols, q->w, q->h, BLIT_COPY);
+    }
+    return n < 0 ? -1 : 0;
+}
+
+// Grid to grid, both sides wrapping. Each source piece is contiguous, so it
+// can be blitted straight into the destination. The regions must not overlap.
+int region_copy(CellState *dst, int dst_cols, int dst_rows, int dst_x, int dst_y,
+                const CellState *src, int src_cols, int src_rows, int src_x, int src_y,
+                int w, int h, BlitOp op) {
+    RegionPiece pieces[4];
+    int n = region_split(src_cols, src_rows, src_x, src_y, w, h, pieces);
+    if (n < 0 || w > dst_cols || h > dst_rows)
+        return -1;
+    for (int p = 0; p < n; p++) {
+        const RegionPiece *q = &pieces[p];
+        region_blit(dst, dst_cols, dst_rows, dst_x + q->dx, dst_y + q->dy,
+                    src + (size_t)q->y * src_cols + q->x, q->w, q->h, src_cols, op);
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef REGION_H
+#define REGION_H
+
+#include "game_core.h"
+
+typedef enum { BLIT_COPY = 0, BLIT_OR, BLIT_AND, BLIT_XOR } BlitOp;
+
+// Contiguous part of a wrapped rectangle: w x h cells at grid position
+// (x, y), which are cells (dx, dy) onwards of the rectangle.
+typedef struct {
+    int x, y;
+    int w, h;
+    int dx, dy;
+} RegionPiece;
+
+// Rectangles are given by their top-left corner, which wraps like
+// pos_to_index, and a size no larger than the grid.
+int region_split(int cols, int rows, int x, int y, int w, int h, RegionPiece pieces[4]);
+int region_fill(CellState *grid, int cols, int rows, int x, int y, int w, int h, CellState state);
+int region_blit(CellState *grid, int cols, int rows, int x, int y,
+                const CellState *src, int w, int h, int src_stride, BlitOp op);
+int region_extract(const CellState *grid, int cols, int rows, int x, int y, int w, int h,
+                   CellState *dst, int dst_stride);
+int region_copy(CellState *dst, int dst_cols, int dst_rows, int dst_x, int dst_y,
+                const CellState *src, int src_cols, int src_rows, int src_x, int src_y,
+                int w, int h, BlitOp op);
+
+#endif
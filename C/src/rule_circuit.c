@@ -0,0 +1,282 @@
+#include "rule_circuit.h"
+#include <string.h>
+
+// Boolean minimization over the five circuit inputs. Minterm m encodes the
+// neighbor count in bits 0-3 and the cell state in bit 4; counts 9-15 never
+// come out of bs_count8 and are treated as don't-cares.
+#define N_VARS RULE_CIRCUIT_INPUTS
+#define N_MINTERMS (1 << N_VARS)
+#define MAX_IMPLICANTS 256
+
+typedef struct {
+    uint8_t value;
+    uint8_t mask;  // set bits are eliminated variables
+} Implicant;
+
+static const char *input_names[RULE_CIRCUIT_INPUTS] = {"b0", "b1", "b2", "b3", "alive"};
+
+static int is_dont_care(int m) {
+    return (m & 15) > LIFE_RULE_MAX_NEIGHBORS;
+}
+
+static int literal_count(Implicant imp) {
+    return N_VARS - __builtin_popcount(imp.mask);
+}
+
+static int covers(Implicant imp, int m) {
+    return (m & ~imp.mask & (N_MINTERMS - 1)) == imp.value;
+}
+
+static int add_unique(Implicant *list, int n, Implicant imp) {
+    for (int i = 0; i < n; i++) {
+        if (list[i].value == imp.value && list[i].mask == imp.mask)
+            return n;
+    }
+    list[n] = imp;
+    return n + 1;
+}
+
+// Quine-McCluskey: repeatedly merge implicants differing in one variable.
+static int prime_implicants(const uint8_t *on, Implicant *primes) {
+    Implicant cur[MAX_IMPLICANTS], next[MAX_IMPLICANTS];
+    int n_cur = 0, n_primes = 0;
+
+    for (int m = 0; m < N_MINTERMS; m++) {
+        if (on[m] || is_dont_care(m))
+            cur[n_cur++] = (Implicant){(uint8_t)m, 0};
+    }
+
+    while (n_cur > 0) {
+        uint8_t merged[MAX_IMPLICANTS] = {0};
+        int n_next = 0;
+        for (int i = 0; i < n_cur; i++) {
+            for (int j = i + 1; j < n_cur; j++) {
+                uint8_t diff = cur[i].value ^ cur[j].value;
+                if (cur[i].mask != cur[j].mask || __builtin_popcount(diff) != 1)
+                    continue;
+                Implicant imp = {(uint8_t)(cur[i].value & ~diff), (uint8_t)(cur[i].mask | diff)};
+                n_next = add_unique(next, n_next, imp);
+                merged[i] = merged[j] = 1;
+            }
+        }
+        for (int i = 0; i < n_cur; i++) {
+            if (!merged[i])
+                n_primes = add_unique(primes, n_primes, cur[i]);
+        }
+        memcpy(cur, next, n_next * sizeof(Implicant));
+        n_cur = n_next;
+    }
+    return n_primes;
+}
+
+typedef struct {
+    const Implicant *primes;
+    const uint32_t *cover;  // per prime: on-set minterms it covers
+    int n_primes;
+    uint32_t on_set;
+    int chosen[N_MINTERMS];
+    int best[N_MINTERMS];
+    int n_best;
+    int best_cost;
+} CoverSearch;
+
+// Exact minimum-literal cover by branching on the lowest uncovered minterm.
+static void search_cover(CoverSearch *s, uint32_t covered, int n_chosen, int cost) {
+    if (cost >= s->best_cost)
+        return;
+    if ((covered & s->on_set) == s->on_set) {
+        s->best_cost = cost;
+        s->n_best = n_chosen;
+        memcpy(s->best, s->chosen, n_chosen * sizeof(int));
+        return;
+    }
+    int m = __builtin_ctz(s->on_set & ~covered);
+    for (int p = 0; p < s->n_primes; p++) {
+        if (!((s->cover[p] >> m) & 1))
+            continue;
+        s->chosen[n_chosen] = p;
+        search_cover(s, covered | s->cover[p], n_chosen + 1, cost + literal_count(s->primes[p]) + 1);
+    }
+}
+
+static int minimize(const uint8_t *on, Implicant *terms) {
+    Implicant primes[MAX_IMPLICANTS];
+    uint32_t cover[MAX_IMPLICANTS];
+    int n_primes = prime_implicants(on, primes);
+
+    CoverSearch s = {primes, cover, n_primes, 0, {0}, {0}, 0, 1 << 30};
+    for (int m = 0; m < N_MINTERMS; m++) {
+        if (on[m])
+            s.on_set |= 1u << m;
+    }
+    for (int p = 0; p < n_primes; p++) {
+        cover[p] = 0;
+        for (int m = 0; m < N_MINTERMS; m++) {
+            if (covers(primes[p], m))
+                cover[p] |= 1u << m;
+        }
+    }
+    search_cover(&s, 0, 0, 0);
+
+    for (int i = 0; i < s.n_best; i++)
+        terms[i] = primes[s.best[i]];
+    return s.n_best;
+}
+
+// Appends an op, reusing an identical earlier one (common subexpressions).
+static int emit_op(RuleCircuit *c, RuleOpCode code, int a, int b) {
+    if ((code == RC_AND || code == RC_OR) && a > b) {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    for (int i = 0; i < c->n_ops; i++) {
+        const RuleOp *op = &c->ops[i];
+        if (op->code == code && op->a == a && op->b == b)
+            return op->dst;
+    }
+    if (c->n_ops == RULE_CIRCUIT_MAX_OPS)
+        return -1;
+    int dst = c->n_regs++;
+    c->ops[c->n_ops++] = (RuleOp){(uint8_t)code, (uint8_t)dst, (uint8_t)a, (uint8_t)b};
+    return dst;
+}
+
+// Builds positives AND'ed together, minus the OR of the negated variables.
+static int emit_term(RuleCircuit *c, Implicant term) {
+    int pos = -1, neg = -1;
+    for (int v = 0; v < N_VARS; v++) {
+        if ((term.mask >> v) & 1)
+            continue;
+        if ((term.value >> v) & 1)
+            pos = pos < 0 ? v : emit_op(c, RC_AND, pos, v);
+        else
+            neg = neg < 0 ? v : emit_op(c, RC_OR, neg, v);
+        if (c->n_ops == RULE_CIRCUIT_MAX_OPS)
+            return -1;
+    }
+    if (neg < 0)
+        return pos < 0 ? emit_op(c, RC_ONE, 0, 0) : pos;
+    return pos < 0 ? emit_op(c, RC_NOT, neg, 0) : emit_op(c, RC_ANDN, pos, neg);
+}
+
+static int build(RuleCircuit *c, const LifeRule *rule, int invert) {
+    uint8_t on[N_MINTERMS] = {0};
+    Implicant terms[N_MINTERMS];
+
+    memset(c, 0, sizeof(*c));
+    c->n_regs = RULE_CIRCUIT_INPUTS;
+    for (int m = 0; m < N_MINTERMS; m++) {
+        if (!is_dont_care(m))
+            on[m] = rule->table[LIFE_RULE_INDEX(m >> 4, m & 15)] ^ invert;
+    }
+
+    int n_terms = minimize(on, terms);
+    int sum = -1;
+    for (int i = 0; i < n_terms; i++) {
+        int t = emit_term(c, terms[i]);
+        if (t < 0)
+            return -1;
+        sum = sum < 0 ? t : emit_op(c, RC_OR, sum, t);
+    }
+    if (sum < 0)
+        sum = emit_op(c, RC_ZERO, 0, 0);
+    if (invert)
+        sum = emit_op(c, RC_NOT, sum, 0);
+    c->output = sum;
+    return sum < 0 ? -1 : 0;
+}
+
+// Synthesizes both the rule and its complement and keeps the shorter circuit.
+int rule_circuit_compile(RuleCircuit *circuit, const LifeRule *rule) {
+    RuleCircuit inverted;
+    int ok = build(circuit, rule, 0) == 0;
+    int ok_inverted = build(&inverted, rule, 1) == 0;
+
+    if (ok_inverted && (!ok || inverted.n_ops < circuit->n_ops))
+        *circuit = inverted;
+    return ok || ok_inverted ? 0 : -1;
+}
+
+uint64_t rule_circuit_eval(const RuleCircuit *circuit, uint64_t alive,
+                           uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {
+    uint64_t r[RULE_CIRCUIT_MAX_REGS];
+    r[RC_B0] = b0;
+    r[RC_B1] = b1;
+    r[RC_B2] = b2;
+    r[RC_B3] = b3;
+    r[RC_ALIVE] = alive;
+    for (int i = 0; i < circuit->n_ops; i++) {
+        const RuleOp *op = &circuit->ops[i];
+        switch (op->code) {
+        case RC_AND: r[op->dst] = r[op->a] & r[op->b]; break;
+        case RC_OR: r[op->dst] = r[op->a] | r[op->b]; break;
+        case RC_ANDN: r[op->dst] = r[op->a] & ~r[op->b]; break;
+        case RC_NOT: r[op->dst] = ~r[op->a]; break;
+        case RC_ZERO: r[op->dst] = 0; break;
+        case RC_ONE: r[op->dst] = ~0ULL; break;
+        }
+    }
+    return r[circuit->output];
+}
+
+// Register k lives at regs[k * n_words]; the caller fills the input registers.
+// Dispatch happens once per op and row, and the inner loops vectorize.
+uint64_t *rule_circuit_eval_rows(const RuleCircuit *circuit, uint64_t *regs, size_t n_words) {
+    for (int i = 0; i < circuit->n_ops; i++) {
+        const RuleOp *op = &circuit->ops[i];
+        uint64_t *d = regs + op->dst * n_words;
+        const uint64_t *a = regs + op->a * n_words;
+        const uint64_t *b = regs + op->b * n_words;
+        switch (op->code) {
+        case RC_AND: for (size_t w = 0; w < n_words; w++) d[w] = a[w] & b[w]; break;
+        case RC_OR: for (size_t w = 0; w < n_words; w++) d[w] = a[w] | b[w]; break;
+        case RC_ANDN: for (size_t w = 0; w < n_words; w++) d[w] = a[w] & ~b[w]; break;
+        case RC_NOT: for (size_t w = 0; w < n_words; w++) d[w] = ~a[w]; break;
+        case RC_ZERO: memset(d, 0, n_words * sizeof(uint64_t)); break;
+        case RC_ONE: memset(d, 0xff, n_words * sizeof(uint64_t)); break;
+        }
+    }
+    return regs + circuit->output * n_words;
+}
+
+static void print_reg(FILE *out, int reg) {
+    if (reg < RULE_CIRCUIT_INPUTS)
+        fprintf(out, "%s", input_names[reg]);
+    else
+        fprintf(out, "r%d", reg);
+}
+
+// Writes the circuit as a static inline C function of (alive, b0, b1, b2, b3).
+void rule_circuit_emit_c(const RuleCircuit *circuit, FILE *out, const char *function_name) {
+    fprintf(out, "static inline uint64_t %s(uint64_t alive, uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3) {\n",
+            function_name);
+    fprintf(out, "    (void)alive; (void)b0; (void)b1; (void)b2; (void)b3;\n");
+    for (int i = 0; i < circuit->n_ops; i++) {
+        const RuleOp *op = &circuit->ops[i];
+        fprintf(out, "    uint64_t r%d = ", op->dst);
+        switch (op->code) {
+        case RC_AND:
+        case RC_OR:
+        case RC_ANDN:
+            print_reg(out, op->a);
+            fprintf(out, op->code == RC_AND ? " & " : op->code == RC_OR ? " | " : " & ~");
+            print_reg(out, op->b);
+            break;
+        case RC_NOT:
+            fprintf(out, "~");
+            print_reg(out, op->a);
+            break;
+        case RC_ZERO:
+            fprintf(out, "0");
+            break;
+        case RC_ONE:
+            fprintf(out, "~(uint64_t)0");
+            break;
+        }
+        fprintf(out, ";\n");
+    }
+    fprintf(out, "    return ");
+    print_reg(out, circuit->output);
+    fprintf(out, ";\n}\n");
+}
@@ -0,0 +1,40 @@
+#ifndef RULE_CIRCUIT_H
+#define RULE_CIRCUIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "life_rule.h"
+
+// Inputs occupy the first registers: the four bits of the bitsliced neighbor
+// count (see bs_count8) followed by the current cell state.
+enum { RC_B0 = 0, RC_B1, RC_B2, RC_B3, RC_ALIVE, RULE_CIRCUIT_INPUTS };
+
+#define RULE_CIRCUIT_MAX_OPS 128
+#define RULE_CIRCUIT_MAX_REGS (RULE_CIRCUIT_INPUTS + RULE_CIRCUIT_MAX_OPS)
+
+typedef enum { RC_AND, RC_OR, RC_ANDN, RC_NOT, RC_ZERO, RC_ONE } RuleOpCode;
+
+// dst = a OP b, where ANDN is a & ~b. Every op writes a fresh register.
+typedef struct {
+    uint8_t code;
+    uint8_t dst;
+    uint8_t a;
+    uint8_t b;
+} RuleOp;
+
+// Minimized boolean circuit computing the next state of 64 cells per word.
+typedef struct {
+    int n_ops;
+    int n_regs;
+    int output;
+    RuleOp ops[RULE_CIRCUIT_MAX_OPS];
+} RuleCircuit;
+
+int rule_circuit_compile(RuleCircuit *circuit, const LifeRule *rule);
+uint64_t rule_circuit_eval(const RuleCircuit *circuit, uint64_t alive,
+                           uint64_t b0, uint64_t b1, uint64_t b2, uint64_t b3);
+uint64_t *rule_circuit_eval_rows(const RuleCircuit *circuit, uint64_t *regs, size_t n_words);
+void rule_circuit_emit_c(const RuleCircuit *circuit, FILE *out, const char *function_name);
+
+#endif
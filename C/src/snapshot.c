@@ -0,0 +1,110 @@
+#include "snapshot.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+struct SnapshotRing {
+    int cols;
+    int rows;
+    int n_slots;
+    int max_readers;
+    int back;                // written only by the writer
+    atomic_int published;    // -1 until the first publish
+    atomic_int holders;      // views currently held
+    CellState *cells;        // n_slots grids back to back
+    uint64_t *generations;   // per slot, set before the slot is published
+    atomic_int *refs;        // per slot, readers holding it
+};
+
+static CellState *slot_cells(const SnapshotRing *ring, int slot) {
+    return ring->cells + (size_t)slot * ring->cols * ring->rows;
+}
+
+SnapshotRing *snapshot_ring_create(int cols, int rows, int max_readers) {
+    if (cols < 1 || rows < 1 || max_readers < 1)
+        return NULL;
+    SnapshotRing *ring = calloc(1, sizeof(*ring));
+    if (!ring)
+        return NULL;
+    ring->cols = cols;
+    ring->rows = rows;
+    ring->max_readers = max_readers;
+    ring->n_slots = max_readers + 2;
+    ring->cells = calloc((size_t)ring->n_slots * cols * rows, sizeof(CellState));
+    ring->generations = calloc(ring->n_slots, sizeof(uint64_t));
+    ring->refs = calloc(ring->n_slots, sizeof(atomic_int));
+    if (!ring->cells || !ring->generations || !ring->refs) {
+        snapshot_ring_destroy(ring);
+        return NULL;
+    }
+    for (int i = 0; i < ring->n_slots; i++)
+        atomic_init(&ring->refs[i], 0);
+    atomic_init(&ring->published, -1);
+    atomic_init(&ring->holders, 0);
+    ring->back = 0;
+    return ring;
+}
+
+void snapshot_ring_destroy(SnapshotRing *ring) {
+    if (!ring)
+        return;
+    free(ring->cells);
+    free(ring->generations);
+    free(ring->refs);
+    free(ring);
+}
+
+CellState *snapshot_back_buffer(SnapshotRing *ring) {
+    return slot_cells(ring, ring->back);
+}
+
+// The grid last published by this writer, or NULL before the first publish.
+// Only the writer may call this; readers use snapshot_acquire.
+const CellState *snapshot_front_buffer(const SnapshotRing *ring) {
+    int slot = atomic_load_explicit(&ring->published, memory_order_relaxed);
+    return slot < 0 ? NULL : slot_cells(ring, slot);
+}
+
+// Publishes the back buffer and claims a slot no reader holds as the next one.
+// A reader that loaded the old index before its reference became visible
+// re-checks published and backs off, so a zero count here is final.
+void snapshot_publish(SnapshotRing *ring, uint64_t generation) {
+    ring->generations[ring->back] = generation;
+    int published = ring->back;
+    atomic_store(&ring->published, published);
+    for (int i = 1; i < ring->n_slots; i++) {
+        int slot = (published + i) % ring->n_slots;
+        if (atomic_load(&ring->refs[slot]) == 0) {
+            ring->back = slot;
+            return;
+        }
+    }
+}
+
+// Returns -1 before the first publish or when max_readers views are held.
+int snapshot_acquire(SnapshotRing *ring, SnapshotView *view) {
+    if (atomic_fetch_add(&ring->holders, 1) >= ring->max_readers) {
+        atomic_fetch_sub(&ring->holders, 1);
+        return -1;
+    }
+    for (;;) {
+        int slot = atomic_load(&ring->published);
+        if (slot < 0) {
+            atomic_fetch_sub(&ring->holders, 1);
+            return -1;
+        }
+        atomic_fetch_add(&ring->refs[slot], 1);
+        if (atomic_load(&ring->published) == slot) {
+            view->cells = slot_cells(ring, slot);
+            view->generation = ring->generations[slot];
+            view->slot = slot;
+            return 0;
+        }
+        atomic_fetch_sub(&ring->refs[slot], 1);
+    }
+}
+
+void snapshot_release(SnapshotRing *ring, SnapshotView *view) {
+    atomic_fetch_sub_explicit(&ring->refs[view->slot], 1, memory_order_release);
+    atomic_fetch_sub(&ring->holders, 1);
+    view->cells = NULL;
+}
@@ -0,0 +1,33 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include "game_core.h"
+
+// Publication of whole grids from one writer thread to any number of reader
+// threads. The ring holds max_readers + 2 grids: the published one, the
+// writer's back buffer, and one per reader holding a view, so the writer
+// always finds a free back buffer and never waits. Readers never take locks;
+// acquiring only retries when a publish lands in between.
+typedef struct SnapshotRing SnapshotRing;
+
+// Immutable until released. generation is the tag passed to snapshot_publish.
+typedef struct {
+    const CellState *cells;
+    uint64_t generation;
+    int slot;
+} SnapshotView;
+
+SnapshotRing *snapshot_ring_create(int cols, int rows, int max_readers);
+void snapshot_ring_destroy(SnapshotRing *ring);
+
+// Writer side.
+CellState *snapshot_back_buffer(SnapshotRing *ring);
+const CellState *snapshot_front_buffer(const SnapshotRing *ring);
+void snapshot_publish(SnapshotRing *ring, uint64_t generation);
+
+// Reader side, from any thread.
+int snapshot_acquire(SnapshotRing *ring, SnapshotView *view);
+void snapshot_release(SnapshotRing *ring, SnapshotView *view);
+
+#endif
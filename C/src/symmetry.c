@@ -0,0 +1,171 @@
+#include "symmetry.h"
+#include "random_fill.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *names[] = {"C2_4", "D2_+2", "D4_+4"};
+
+// Accepts the apgsearch names or the short forms "C2", "D2" and "D4".
+int symmetry_parse(Symmetry *symmetry, const char *name) {
+    static const char *short_names[] = {"C2", "D2", "D4"};
+    for (int i = 0; i < 3; i++) {
+        if (strcmp(name, names[i]) == 0 || strcmp(name, short_names[i]) == 0) {
+            *symmetry = (Symmetry)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char *symmetry_name(Symmetry symmetry) {
+    return names[symmetry];
+}
+
+// Maps full-board coordinates (any integers, wrapped like pos_to_index) to
+// the domain cell holding the same state.
+static void fold(const SymmetricSoup *soup, int *x, int *y) {
+    int i = wrap_index(*x, *y, soup->cols, soup->rows);
+    *x = i % soup->cols;
+    *y = i / soup->cols;
+    switch (soup->symmetry) {
+    case SYMMETRY_C2:
+        if (*y >= soup->dom_rows) {
+            *x = soup->cols - 1 - *x;
+            *y = soup->rows - 1 - *y;
+        }
+        break;
+    case SYMMETRY_D2:
+        if (*y >= soup->dom_rows)
+            *y = soup->rows - 1 - *y;
+        break;
+    case SYMMETRY_D4:
+        if (*x >= soup->dom_cols)
+            *x = soup->cols - 1 - *x;
+        if (*y >= soup->dom_rows)
+            *y = soup->rows - 1 - *y;
+        break;
+    }
+}
+
+static int padded_index(const SymmetricSoup *soup, int x, int y) {
+    return (y + 1) * soup->stride + x + 1;
+}
+
+int symmetric_soup_init(SymmetricSoup *soup, int cols, int rows, Symmetry symmetry, const LifeRule *rule) {
+    memset(soup, 0, sizeof(*soup));
+    if (symmetry < SYMMETRY_C2 || symmetry > SYMMETRY_D4 || cols < 1 || rows < 2 || rows % 2 ||
+        (symmetry == SYMMETRY_D4 && cols % 2))
+        return -1;
+    soup->cols = cols;
+    soup->rows = rows;
+    soup->dom_cols = symmetry == SYMMETRY_D4 ? cols / 2 : cols;
+    soup->dom_rows = rows / 2;
+    soup->stride = soup->dom_cols + 2;
+    soup->symmetry = symmetry;
+    soup->rule = *rule;
+
+    size_t padded = (size_t)soup->stride * (soup->dom_rows + 2);
+    int max_halo = 2 * soup->stride + 2 * soup->dom_rows;
+    soup->grid1 = calloc(padded, sizeof(CellState));
+    soup->grid2 = calloc(padded, sizeof(CellState));
+    soup->halo_dst = malloc(max_halo * sizeof(int));
+    soup->halo_src = malloc(max_halo * sizeof(int));
+    if (!soup->grid1 || !soup->grid2 || !soup->halo_dst || !soup->halo_src) {
+        symmetric_soup_free(soup);
+        return -1;
+    }
+    soup->current_grid = soup->grid1;
+    soup->next_grid = soup->grid2;
+
+    for (int y = -1; y <= soup->dom_rows; y++) {
+        for (int x = -1; x <= soup->dom_cols; x++) {
+            if (x >= 0 && x < soup->dom_cols && y >= 0 && y < soup->dom_rows)
+                continue;
+            int sx = x, sy = y;
+            fold(soup, &sx, &sy);
+            soup->halo_dst[soup->n_halo] = padded_index(soup, x, y);
+            soup->halo_src[soup->n_halo] = padded_index(soup, sx, sy);
+            soup->n_halo++;
+        }
+    }
+    return 0;
+}
+
+void symmetric_soup_free(SymmetricSoup *soup) {
+    free(soup->grid1);
+    free(soup->grid2);
+    free(soup->halo_dst);
+    free(soup->halo_src);
+    memset(soup, 0, sizeof(*soup));
+}
+
+// Coordinates are on the full board.
+CellState symmetric_soup_get(const SymmetricSoup *soup, int x, int y) {
+    fold(soup, &x, &y);
+    return soup->current_grid[padded_index(soup, x, y)];
+}
+
+// Sets the cell and, implicitly, all of its images.
+void symmetric_soup_set(SymmetricSoup *soup, int x, int y, CellState state) {
+    fold(soup, &x, &y);
+    soup->current_grid[padded_index(soup, x, y)] = state;
+}
+
+// Seeded like random_fill, drawn over the domain only: the domain is filled
+// row-major into next_grid, which the next step overwrites anyway, and then
+// copied into place.
+void symmetric_soup_randomize(SymmetricSoup *soup, double density, uint64_t seed) {
+    random_fill(soup->next_grid, (size_t)soup->dom_rows * soup->dom_cols, density, seed);
+    for (int y = 0; y < soup->dom_rows; y++)
+        memcpy(soup->current_grid + padded_index(soup, 0, y), soup->next_grid + (size_t)y * soup->dom_cols,
+                soup->dom_cols * sizeof(CellState));
+}
+
+// Takes the domain from a full cols x rows board, which should already have
+// the symmetry.
+void symmetric_soup_load(SymmetricSoup *soup, const CellState *grid) {
+    for (int y = 0; y < soup->dom_rows; y++)
+        memcpy(soup->current_grid + padded_index(soup, 0, y), grid + (size_t)y * soup->cols,
+               soup->dom_cols * sizeof(CellState));
+}
+
+void symmetric_soup_store(const SymmetricSoup *soup, CellState *grid) {
+    for (int y = 0; y < soup->rows; y++) {
+        for (int x = 0; x < soup->cols; x++)
+            grid[(size_t)y * soup->cols + x] = symmetric_soup_get(soup, x, y);
+    }
+}
+
+void symmetric_soup_step(SymmetricSoup *soup) {
+    CellState *curr = soup->current_grid, *next = soup->next_grid;
+    for (int i = 0; i < soup->n_halo; i++)
+        curr[soup->halo_dst[i]] = curr[soup->halo_src[i]];
+
+    // The halo makes every neighbor a plain offset, so rows need no wrapping.
+    for (int y = 0; y < soup->dom_rows; y++) {
+        const CellState *mid = curr + padded_index(soup, 0, y);
+        const CellState *up = mid - soup->stride;
+        const CellState *down = mid + soup->stride;
+        CellState *out = next + padded_index(soup, 0, y);
+        for (int x = 0; x < soup->dom_cols; x++) {
+            int alive_count = up[x - 1] + up[x] + up[x + 1] + mid[x - 1] + mid[x + 1] +
+                              down[x - 1] + down[x] + down[x + 1];
+            out[x] = (CellState)soup->rule.table[LIFE_RULE_INDEX(mid[x], alive_count)];
+        }
+    }
+
+    CellState *temp = soup->current_grid;
+    soup->current_grid = soup->next_grid;
+    soup->next_grid = temp;
+}
+
+// Population of the full board.
+long symmetric_soup_population(const SymmetricSoup *soup) {
+    long n = 0;
+    for (int y = 0; y < soup->dom_rows; y++) {
+        const CellState *row = soup->current_grid + padded_index(soup, 0, y);
+        for (int x = 0; x < soup->dom_cols; x++)
+            n += row[x] == ALIVE;
+    }
+    return n * (soup->cols * soup->rows / (soup->dom_cols * soup->dom_rows));
+}
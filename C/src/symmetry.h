@@ -0,0 +1,49 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <stdint.h>
+#include "game_core.h"
+#include "life_rule.h"
+
+// Soup symmetries, as in apgsearch's C2_4, D2_+2 and D4_+4: 180-degree
+// rotation, mirror across the horizontal midline, and mirrors across both
+// midlines. The torus needs an even number of rows (and of columns for D4).
+// Every rule preserves these symmetries, so only the fundamental domain (the
+// top half, or the top-left quadrant for D4) needs to be simulated.
+typedef enum {
+    SYMMETRY_C2 = 0,
+    SYMMETRY_D2 = 1,
+    SYMMETRY_D4 = 2
+} Symmetry;
+
+// Fundamental domain stored with a one-cell halo; the halo is rebuilt from
+// domain cells through the symmetry before each step.
+typedef struct {
+    int cols;              // full board
+    int rows;
+    int dom_cols;          // fundamental domain
+    int dom_rows;
+    int stride;            // dom_cols + 2
+    Symmetry symmetry;
+    LifeRule rule;
+    CellState *grid1, *grid2;
+    CellState *current_grid;
+    CellState *next_grid;
+    int *halo_dst;         // padded index of each halo cell ...
+    int *halo_src;         // ... and the domain cell it mirrors
+    int n_halo;
+} SymmetricSoup;
+
+int symmetry_parse(Symmetry *symmetry, const char *name);
+const char *symmetry_name(Symmetry symmetry);
+int symmetric_soup_init(SymmetricSoup *soup, int cols, int rows, Symmetry symmetry, const LifeRule *rule);
+void symmetric_soup_free(SymmetricSoup *soup);
+CellState symmetric_soup_get(const SymmetricSoup *soup, int x, int y);
+void symmetric_soup_set(SymmetricSoup *soup, int x, int y, CellState state);
+void symmetric_soup_randomize(SymmetricSoup *soup, double density, uint64_t seed);
+void symmetric_soup_load(SymmetricSoup *soup, const CellState *grid);
+void symmetric_soup_store(const SymmetricSoup *soup, CellState *grid);
+void symmetric_soup_step(SymmetricSoup *soup);
+long symmetric_soup_population(const SymmetricSoup *soup);
+
+#endif
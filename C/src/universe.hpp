@@ -0,0 +1,505 @@
+#ifndef GOL_UNIVERSE_HPP
+#define GOL_UNIVERSE_HPP
+
+// C++20 front end over the C engines. A Universe is configured by four
+// policies resolved at compile time:
+//   Storage   Bytes (one CellState per cell) or Bits (64 cells per word)
+//   Rule      StaticRule<birth, survive> masks, or DynamicRule from a string
+//   Boundary  Torus or DeadEdges
+//   Executor  Serial or Parallel (rows spread over the worker pool; bit-packed
+//             storage always steps on the calling thread)
+// All buffers are allocated by the constructor; step() never allocates. Byte
+// grids come from the per-thread grid pool, so creating and destroying
+// universes of a recurring size reuses warm buffers without calling malloc.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <new>
+#include <semaphore>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "generator.hpp"
+
+extern "C" {
+#include "bitgrid.h"
+#include "game_core.h"
+#include "grid_alloc.h"
+#include "grid_pool.h"
+#include "life_rule.h"
+#include "parallel.h"
+#include "rule_circuit.h"
+}
+
+namespace gol {
+
+// ---- Rules ----
+
+template <uint16_t Birth, uint16_t Survive>
+struct StaticRule {
+    static constexpr std::array<uint8_t, LIFE_RULE_TABLE_SIZE> table = [] {
+        std::array<uint8_t, LIFE_RULE_TABLE_SIZE> t{};
+        for (int n = 0; n <= LIFE_RULE_MAX_NEIGHBORS; n++) {
+            t[LIFE_RULE_INDEX(0, n)] = (Birth >> n) & 1;
+            t[LIFE_RULE_INDEX(1, n)] = (Survive >> n) & 1;
+        }
+        return t;
+    }();
+
+    static constexpr uint8_t next(int state, int count) { return table[LIFE_RULE_INDEX(state, count)]; }
+
+    static LifeRule c_rule() {
+        LifeRule rule;
+        life_rule_from_masks(&rule, Birth, Survive);
+        return rule;
+    }
+};
+
+using Conway = StaticRule<1u << 3, (1u << 2) | (1u << 3)>;
+using HighLife = StaticRule<(1u << 3) | (1u << 6), (1u << 2) | (1u << 3)>;
+
+class DynamicRule {
+public:
+    DynamicRule() : rule_(LIFE_RULE_CONWAY) {}
+    explicit DynamicRule(const LifeRule &rule) : rule_(rule) {}
+    explicit DynamicRule(const char *rulestring) {
+        if (life_rule_parse(&rule_, rulestring) != 0)
+            throw std::invalid_argument("invalid rulestring");
+    }
+
+    uint8_t next(int state, int count) const { return rule_.table[LIFE_RULE_INDEX(state, count)]; }
+    const LifeRule &c_rule() const { return rule_; }
+
+private:
+    LifeRule rule_;
+};
+
+// ---- Boundaries, storage and executors ----
+
+struct Torus {};
+struct DeadEdges {};
+
+struct Bytes {};
+struct Bits {};
+
+struct Serial {
+    template <class F>
+    void for_rows(int rows, F &fn) const {
+        fn(0, rows);
+    }
+};
+
+// Rows are split over the process-wide pool; the callable is passed by
+// address, so nothing is allocated per call.
+struct Parallel {
+    template <class F>
+    void for_rows(int rows, F &fn) const {
+        parallel_for(0, rows, [](int begin, int end, void *ctx) { (*static_cast<F *>(ctx))(begin, end); }, &fn);
+    }
+};
+
+// ---- Buffers ----
+
+// Move-only owner of a zeroed cols x rows CellState grid, drawn from the
+// calling thread's grid pool and returned to it on destruction.
+class CellBuffer {
+public:
+    using value_type = CellState;
+
+    CellBuffer() = default;
+    CellBuffer(int cols, int rows) : cols_(cols), rows_(rows) {
+        if (cols < 1 || rows < 1)
+            throw std::invalid_argument("grid size must be positive");
+        if (grid_pool_alloc(&buf_, (size_t)cols * rows) != 0)
+            throw std::bad_alloc();
+    }
+    ~CellBuffer() { grid_pool_free(&buf_); }
+    CellBuffer(CellBuffer &&other) noexcept { swap(other); }
+    CellBuffer &operator=(CellBuffer &&other) noexcept {
+        CellBuffer moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    CellBuffer(const CellBuffer &) = delete;
+    CellBuffer &operator=(const CellBuffer &) = delete;
+
+    void swap(CellBuffer &other) noexcept {
+        std::swap(cols_, other.cols_);
+        std::swap(rows_, other.rows_);
+        std::swap(buf_, other.buf_);
+    }
+
+    int cols() const { return cols_; }
+    int rows() const { return rows_; }
+    CellState *data() { return buf_.cells; }
+    const CellState *data() const { return buf_.cells; }
+    std::span<CellState> cells() { return {buf_.cells, (size_t)cols_ * rows_}; }
+    std::span<const CellState> cells() const { return {buf_.cells, (size_t)cols_ * rows_}; }
+    std::span<CellState> row(int y) { return {buf_.cells + (size_t)y * cols_, (size_t)cols_}; }
+    std::span<const CellState> row(int y) const { return {buf_.cells + (size_t)y * cols_, (size_t)cols_}; }
+    GridBacking backing() const { return buf_.backing; }
+
+private:
+    int cols_ = 0;
+    int rows_ = 0;
+    GridBuffer buf_{};
+};
+
+// Move-only owner of a BitGrid.
+class BitBuffer {
+public:
+    using value_type = uint64_t;
+
+    BitBuffer() = default;
+    BitBuffer(int cols, int rows) {
+        if (cols < 1 || rows < 1)
+            throw std::invalid_argument("grid size must be positive");
+        if (bitgrid_init(&grid_, cols, rows) != 0)
+            throw std::bad_alloc();
+    }
+    ~BitBuffer() { bitgrid_free(&grid_); }
+    BitBuffer(BitBuffer &&other) noexcept { swap(other); }
+    BitBuffer &operator=(BitBuffer &&other) noexcept {
+        BitBuffer moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    BitBuffer(const BitBuffer &) = delete;
+    BitBuffer &operator=(const BitBuffer &) = delete;
+
+    void swap(BitBuffer &other) noexcept { std::swap(grid_, other.grid_); }
+
+    int cols() const { return grid_.cols; }
+    int rows() const { return grid_.rows; }
+    BitGrid *c_grid() { return &grid_; }
+    const BitGrid *c_grid() const { return &grid_; }
+    std::span<uint64_t> row(int y) { return {grid_.words + (size_t)y * grid_.words_per_row, (size_t)grid_.words_per_row}; }
+    std::span<const uint64_t> row(int y) const {
+        return {grid_.words + (size_t)y * grid_.words_per_row, (size_t)grid_.words_per_row};
+    }
+
+private:
+    BitGrid grid_{};
+};
+
+// ---- Asynchronous stepping ----
+
+// Handle to a step_async request. The generations run on the pool's task
+// thread (see parallel_submit), so a Parallel universe still spreads each
+// generation over the workers. Cancellation is checked between generations.
+class StepJob {
+public:
+    // Invoked on the task thread once the future is ready, so it may call
+    // wait(); it is skipped if a step threw, and must not throw itself.
+    using Callback = std::function<void(uint64_t completed, bool cancelled)>;
+
+    uint64_t requested() const { return requested_; }
+    uint64_t completed() const { return completed_.load(std::memory_order_acquire); }
+    bool done() const { return done_.load(std::memory_order_acquire); }
+    void cancel() { cancel_.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return cancel_.load(std::memory_order_relaxed); }
+
+    // Resolves to the number of generations completed.
+    std::shared_future<uint64_t> future() const { return future_; }
+    uint64_t wait() const { return future_.get(); }
+
+private:
+    template <class, class, class, class>
+    friend class Universe;
+
+    using StepFn = void (*)(void *universe);
+
+    StepJob(uint64_t n, StepFn step, void *universe, Callback on_done)
+        : requested_(n), step_(step), universe_(universe), on_done_(std::move(on_done)),
+          future_(promise_.get_future().share()) {
+        task_.fn = run;
+        task_.ctx = this;
+    }
+
+    static std::shared_ptr<StepJob> launch(uint64_t n, StepFn step, void *universe, Callback on_done) {
+        std::shared_ptr<StepJob> job(new StepJob(n, step, universe, std::move(on_done)));
+        job->self_ = job;
+        if (parallel_submit(&job->task_) != 0) {
+            job->self_.reset();
+            throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again),
+                                    "cannot start the task thread");
+        }
+        return job;
+    }
+
+    static void run(void *ctx) {
+        StepJob *job = static_cast<StepJob *>(ctx);
+        std::shared_ptr<StepJob> keep = std::move(job->self_);  // submitter may have dropped its handle
+        uint64_t k = 0;
+        std::exception_ptr error;
+        try {
+            for (; k < job->requested_ && !job->cancelled(); k++) {
+                job->step_(job->universe_);
+                job->completed_.store(k + 1, std::memory_order_release);
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        job->done_.store(true, std::memory_order_release);
+        if (error) {
+            job->promise_.set_exception(error);
+            return;
+        }
+        job->promise_.set_value(k);
+        notify(job, k);
+    }
+
+    // noexcept: an exception must not unwind into the C task thread.
+    static void notify(StepJob *job, uint64_t k) noexcept {
+        if (job->on_done_)
+            job->on_done_(k, k < job->requested_);
+    }
+
+    uint64_t requested_;
+    StepFn step_;
+    void *universe_;
+    Callback on_done_;
+    std::promise<uint64_t> promise_;
+    std::shared_future<uint64_t> future_;
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<bool> cancel_{false};
+    std::atomic<bool> done_{false};
+    ParallelTask task_{};
+    std::shared_ptr<StepJob> self_;
+};
+
+// ---- Universe ----
+
+template <class Storage = Bytes, class Rule = Conway, class Boundary = Torus, class Executor = Serial>
+class Universe {
+    static constexpr bool packed = std::is_same_v<Storage, Bits>;
+    static_assert(packed || std::is_same_v<Storage, Bytes>, "Storage must be Bytes or Bits");
+    static_assert(std::is_same_v<Boundary, Torus> || std::is_same_v<Boundary, DeadEdges>,
+                  "Boundary must be Torus or DeadEdges");
+    static_assert(!(packed && std::is_same_v<Boundary, DeadEdges>), "bit-packed storage wraps at the edges");
+
+public:
+    using Buffer = std::conditional_t<packed, BitBuffer, CellBuffer>;
+
+    Universe(int cols, int rows, Rule rule = Rule{})
+        : rule_(std::move(rule)), curr_(cols, rows), next_(cols, rows), cols_(cols), rows_(rows) {
+        if constexpr (packed) {
+            LifeRule c_rule = rule_.c_rule();
+            rule_circuit_compile(&circuit_, &c_rule);
+            scratch_ = std::make_unique<uint64_t[]>(bitgrid_scratch_words(curr_.c_grid()));
+        } else if constexpr (std::is_same_v<Boundary, DeadEdges>) {
+            dead_row_ = CellBuffer(cols, 1);
+        }
+    }
+
+    Universe(Universe &&) noexcept = default;
+    Universe &operator=(Universe &&) noexcept = default;
+    Universe(const Universe &) = delete;
+    Universe &operator=(const Universe &) = delete;
+
+    int cols() const { return cols_; }
+    int rows() const { return rows_; }
+    uint64_t generation() const { return generation_; }
+    const Rule &rule() const { return rule_; }
+
+    // Zero-copy access to the current generation.
+    Buffer &buffer() { return curr_; }
+    const Buffer &buffer() const { return curr_; }
+    auto row(int y) { return curr_.row(y); }
+    auto row(int y) const { return curr_.row(y); }
+
+    // Coordinates wrap like pos_to_index.
+    CellState get(int x, int y) const {
+        if constexpr (packed)
+            return bitgrid_get(curr_.c_grid(), x, y);
+        else
+            return curr_.data()[wrap_index(x, y, cols_, rows_)];
+    }
+
+    void set(int x, int y, CellState state) {
+        if constexpr (packed)
+            bitgrid_set(curr_.c_grid(), x, y, state);
+        else
+            curr_.data()[wrap_index(x, y, cols_, rows_)] = state;
+    }
+
+    // Clears every cell and restarts the generation count without allocating.
+    void reset() {
+        if constexpr (packed) {
+            BitGrid *g = curr_.c_grid();
+            std::memset(g->words, 0, (size_t)g->words_per_row * g->rows * sizeof(uint64_t));
+        } else {
+            std::memset(curr_.data(), 0, (size_t)cols_ * rows_ * sizeof(CellState));
+        }
+        generation_ = 0;
+    }
+
+    uint64_t population() const {
+        uint64_t n = 0;
+        for (int y = 0; y < rows_; y++) {
+            for (auto v : curr_.row(y)) {
+                if constexpr (packed)
+                    n += (uint64_t)__builtin_popcountll(v);
+                else
+                    n += v == ALIVE;
+            }
+        }
+        return n;
+    }
+
+    void step(uint64_t n = 1) {
+        for (uint64_t g = 0; g < n; g++) {
+            compute_next();
+            commit_next();
+        }
+    }
+
+    // Runs n generations off the calling thread. The universe must outlive
+    // the job and must not be used until it is done. Jobs run one at a time
+    // in submission order.
+    std::shared_ptr<StepJob> step_async(uint64_t n, StepJob::Callback on_done = {}) {
+        return StepJob::launch(n, [](void *u) { static_cast<Universe *>(u)->step(); }, this, std::move(on_done));
+    }
+
+    // Lazily yields up to count generations, starting with the current one.
+    // While the consumer holds generation t, a helper thread computes t + 1
+    // into the back buffer; advancing the loop waits for it and swaps. The
+    // coroutine frame and helper thread are set up once per stream. Do not
+    // modify the universe while a stream is live.
+    Generator<const Universe> generations(uint64_t count = std::numeric_limits<uint64_t>::max()) {
+        StepAhead ahead(*this);
+        for (uint64_t i = 0; i < count; i++) {
+            bool more = i + 1 < count;
+            if (more)
+                ahead.start();
+            co_yield *this;
+            if (!more)
+                break;
+            ahead.wait();
+            commit_next();
+        }
+    }
+
+private:
+    // Helper thread for generations(); one step per start()/wait() pair.
+    class StepAhead {
+    public:
+        explicit StepAhead(Universe &u) : u_(u), thread_([this] { run(); }) {}
+        ~StepAhead() {
+            if (busy_)
+                wait();
+            stop_ = true;
+            go_.release();
+            thread_.join();
+        }
+        StepAhead(const StepAhead &) = delete;
+        StepAhead &operator=(const StepAhead &) = delete;
+
+        void start() {
+            busy_ = true;
+            go_.release();
+        }
+        void wait() {
+            done_.acquire();
+            busy_ = false;
+        }
+
+    private:
+        void run() {
+            for (;;) {
+                go_.acquire();
+                if (stop_)
+                    return;
+                u_.compute_next();
+                done_.release();
+            }
+        }
+
+        Universe &u_;
+        std::binary_semaphore go_{0};
+        std::binary_semaphore done_{0};
+        bool busy_ = false;
+        bool stop_ = false;  // published by go_.release()
+        std::thread thread_;
+    };
+
+    // Writes the successor of curr_ into next_; curr_ is only read.
+    void compute_next() {
+        if constexpr (packed) {
+            bitgrid_step(curr_.c_grid(), next_.c_grid(), &circuit_, scratch_.get());
+        } else {
+            auto rows = [this](int begin, int end) { step_rows(begin, end); };
+            executor_.for_rows(rows_, rows);
+        }
+    }
+
+    void commit_next() {
+        curr_.swap(next_);
+        generation_++;
+    }
+
+    // Outer cells of a row, where the neighbor columns may wrap or fall off.
+    CellState edge_cell(const CellState *up, const CellState *mid, const CellState *down, int x) const {
+        int xl = x - 1, xr = x + 1;
+        int count = up[x] + down[x];
+        if constexpr (std::is_same_v<Boundary, Torus>) {
+            xl = xl < 0 ? cols_ - 1 : xl;
+            xr = xr == cols_ ? 0 : xr;
+        }
+        if (xl >= 0 && xl < cols_)
+            count += up[xl] + mid[xl] + down[xl];
+        if (xr >= 0 && xr < cols_)
+            count += up[xr] + mid[xr] + down[xr];
+        return (CellState)rule_.next(mid[x], count);
+    }
+
+    void step_rows(int begin, int end) {
+        const CellState *c = curr_.data();
+        CellState *out_grid = next_.data();
+        for (int y = begin; y < end; y++) {
+            const CellState *mid = c + (size_t)y * cols_;
+            const CellState *up, *down;
+            if constexpr (std::is_same_v<Boundary, Torus>) {
+                up = c + (size_t)(y == 0 ? rows_ - 1 : y - 1) * cols_;
+                down = c + (size_t)(y == rows_ - 1 ? 0 : y + 1) * cols_;
+            } else {
+                up = y == 0 ? dead_row_.data() : mid - cols_;
+                down = y == rows_ - 1 ? dead_row_.data() : mid + cols_;
+            }
+            CellState *out = out_grid + (size_t)y * cols_;
+            out[0] = edge_cell(up, mid, down, 0);
+            for (int x = 1; x < cols_ - 1; x++) {
+                int count = up[x - 1] + up[x] + up[x + 1] + mid[x - 1] + mid[x + 1] +
+                            down[x - 1] + down[x] + down[x + 1];
+                out[x] = (CellState)rule_.next(mid[x], count);
+            }
+            if (cols_ > 1)
+                out[cols_ - 1] = edge_cell(up, mid, down, cols_ - 1);
+        }
+    }
+
+    [[no_unique_address]] Rule rule_;
+    [[no_unique_address]] Executor executor_;
+    Buffer curr_;
+    Buffer next_;
+    int cols_;
+    int rows_;
+    uint64_t generation_ = 0;
+    RuleCircuit circuit_{};
+    std::unique_ptr<uint64_t[]> scratch_;
+    CellBuffer dead_row_;  // zero row above and below (DeadEdges)
+};
+
+}  // namespace gol
+
+#endif
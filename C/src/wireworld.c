@@ -0,0 +1,125 @@
+#include "wireworld.h"
+#include "game_core.h"
+#include <stdlib.h>
+#include <string.h>
+
+int wireworld_init(Wireworld *ww, int cols, int rows) {
+    memset(ww, 0, sizeof(*ww));
+    if (cols < 1 || rows < 1)
+        return -1;
+    size_t n = (size_t)cols * rows;
+    ww->cols = cols;
+    ww->rows = rows;
+    ww->grid1 = calloc(n, 1);
+    ww->grid2 = calloc(n, 1);
+    ww->hits = calloc(n, 1);
+    ww->heads = malloc(n * sizeof(int));
+    ww->tails = malloc(n * sizeof(int));
+    ww->retired = malloc(n * sizeof(int));
+    ww->touched = malloc(n * sizeof(int));
+    if (!ww->grid1 || !ww->grid2 || !ww->hits || !ww->heads || !ww->tails ||
+        !ww->retired || !ww->touched) {
+        wireworld_free(ww);
+        return -1;
+    }
+    ww->current_grid = ww->grid1;
+    ww->next_grid = ww->grid2;
+    return 0;
+}
+
+void wireworld_free(Wireworld *ww) {
+    free(ww->grid1);
+    free(ww->grid2);
+    free(ww->hits);
+    free(ww->heads);
+    free(ww->tails);
+    free(ww->retired);
+    free(ww->touched);
+    memset(ww, 0, sizeof(*ww));
+}
+
+// Rebuilds the lists from current_grid and brings next_grid level with it.
+static void rescan(Wireworld *ww) {
+    size_t n = (size_t)ww->cols * ww->rows;
+    ww->n_heads = ww->n_tails = ww->n_retired = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (ww->current_grid[i] == WW_HEAD)
+            ww->heads[ww->n_heads++] = (int)i;
+        else if (ww->current_grid[i] == WW_TAIL)
+            ww->tails[ww->n_tails++] = (int)i;
+    }
+    memcpy(ww->next_grid, ww->current_grid, n);
+    ww->dirty = 0;
+}
+
+void wireworld_load(Wireworld *ww, const uint8_t *cells) {
+    memcpy(ww->current_grid, cells, (size_t)ww->cols * ww->rows);
+    rescan(ww);
+}
+
+uint8_t wireworld_get(const Wireworld *ww, int x, int y) {
+    return ww->current_grid[wrap_index(x, y, ww->cols, ww->rows)];
+}
+
+void wireworld_set(Wireworld *ww, int x, int y, uint8_t state) {
+    ww->current_grid[wrap_index(x, y, ww->cols, ww->rows)] = state;
+    ww->dirty = 1;
+}
+
+void wireworld_step(Wireworld *ww) {
+    if (ww->dirty)
+        rescan(ww);
+    uint8_t *curr = ww->current_grid, *next = ww->next_grid;
+    int cols = ww->cols, rows = ww->rows;
+
+    // Catch next up to curr: only heads, tails and retired tails changed.
+    for (int i = 0; i < ww->n_heads; i++)
+        next[ww->heads[i]] = WW_HEAD;
+    for (int i = 0; i < ww->n_tails; i++)
+        next[ww->tails[i]] = WW_TAIL;
+    for (int i = 0; i < ww->n_retired; i++)
+        next[ww->retired[i]] = WW_CONDUCTOR;
+
+    // Count head neighbors of the conductors around each head.
+    int n_touched = 0;
+    for (int i = 0; i < ww->n_heads; i++) {
+        int x = ww->heads[i] % cols, y = ww->heads[i] / cols;
+        for (int dy = -1; dy <= 1; dy++) {
+            int ny = y + dy < 0 ? rows - 1 : y + dy == rows ? 0 : y + dy;
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = x + dx < 0 ? cols - 1 : x + dx == cols ? 0 : x + dx;
+                int c = ny * cols + nx;
+                if ((dx || dy) && curr[c] == WW_CONDUCTOR && ww->hits[c]++ == 0)
+                    ww->touched[n_touched++] = c;
+            }
+        }
+    }
+
+    // Heads become tails, tails become conductors, and conductors with one
+    // or two head neighbors become heads. The lists rotate the same way.
+    for (int i = 0; i < ww->n_heads; i++)
+        next[ww->heads[i]] = WW_TAIL;
+    for (int i = 0; i < ww->n_tails; i++)
+        next[ww->tails[i]] = WW_CONDUCTOR;
+
+    int *temp = ww->retired;
+    ww->retired = ww->tails;
+    ww->n_retired = ww->n_tails;
+    ww->tails = ww->heads;
+    ww->n_tails = ww->n_heads;
+    ww->heads = temp;
+    ww->n_heads = 0;
+    for (int i = 0; i < n_touched; i++) {
+        int c = ww->touched[i];
+        if (ww->hits[c] <= 2) {
+            next[c] = WW_HEAD;
+            ww->heads[ww->n_heads++] = c;
+        }
+        ww->hits[c] = 0;
+    }
+
+    uint8_t *swap = ww->current_grid;
+    ww->current_grid = ww->next_grid;
+    ww->next_grid = swap;
+    ww->generation++;
+}
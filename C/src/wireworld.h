@@ -0,0 +1,36 @@
+#ifndef WIREWORLD_H
+#define WIREWORLD_H
+
+#include <stdint.h>
+
+// Wireworld cell states, one byte per cell.
+enum { WW_EMPTY = 0, WW_HEAD = 1, WW_TAIL = 2, WW_CONDUCTOR = 3 };
+
+// Toroidal Wireworld board. Only electron heads can create new heads, so a
+// step visits the head and tail lists and the conductors around heads
+// instead of the whole board. grid1/grid2 are swapped like the front ends'
+// current_grid/next_grid; next lags one generation behind and is caught up
+// by replaying the cells that changed in the previous step.
+typedef struct {
+    int cols;
+    int rows;
+    int generation;
+    uint8_t *grid1, *grid2;
+    uint8_t *current_grid;
+    uint8_t *next_grid;
+    int *heads, n_heads;      // cell indices of the current heads
+    int *tails, n_tails;      // ... current tails
+    int *retired, n_retired;  // tails of the previous generation, now conductors
+    int *touched;             // conductors next to a head, this step
+    uint8_t *hits;            // head neighbors of touched cells, zero otherwise
+    int dirty;                // cells were edited; lists need a rescan
+} Wireworld;
+
+int wireworld_init(Wireworld *ww, int cols, int rows);
+void wireworld_free(Wireworld *ww);
+void wireworld_load(Wireworld *ww, const uint8_t *cells);
+uint8_t wireworld_get(const Wireworld *ww, int x, int y);
+void wireworld_set(Wireworld *ww, int x, int y, uint8_t state);
+void wireworld_step(Wireworld *ww);
+
+#endif
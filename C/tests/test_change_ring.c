@@ -0,0 +1,226 @@
+/*
+ * Tests for the birth/death event ring and the fused event kernel
+ * Compile: make test_change_ring
+ * Run: ./test_change_ring
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "game_core.h"
+
+#define STREAM_GENERATIONS 100
+
+/* Applies one generation of runs to grid; returns the runs dropped in it. */
+static int apply_runs(CellState *grid, const ChangeRun *runs, size_t n, uint32_t generation) {
+    for (size_t i = 0; i < n; i++) {
+        assert(runs[i].generation == generation);
+        if (runs[i].kind == CHANGE_END_OF_GENERATION) {
+            assert(i == n - 1);
+            return runs[i].length;
+        }
+        for (int k = 0; k < runs[i].length; k++) {
+            CellState *cell = &grid[runs[i].y * GRID_COLS + runs[i].x + k];
+            assert(*cell == (runs[i].kind == CHANGE_BIRTH ? DEAD : ALIVE));
+            *cell = runs[i].kind == CHANGE_BIRTH ? ALIVE : DEAD;
+        }
+    }
+    assert(0 && "missing end-of-generation record");
+    return -1;
+}
+
+/* ---- Ring ---- */
+
+TEST(test_ring_fifo_and_wraparound) {
+    ChangeRing *ring = change_ring_create(5);
+    ChangeRun run = {0}, out[8];
+    assert(ring && change_ring_capacity(ring) == 8);
+    assert(change_ring_pop(ring, out, 8) == 0);
+
+    for (uint32_t round = 0; round < 10; round++) {
+        for (uint16_t i = 0; i < 6; i++) {
+            run.generation = round;
+            run.x = i;
+            assert(change_ring_push(ring, &run) == 0);
+        }
+        assert(change_ring_pop(ring, out, 4) == 4);
+        assert(change_ring_pop(ring, out + 4, 8) == 2);
+        for (uint16_t i = 0; i < 6; i++)
+            assert(out[i].generation == round && out[i].x == i);
+    }
+    assert(change_ring_dropped(ring) == 0);
+    change_ring_destroy(ring);
+    assert(change_ring_create(0) == NULL);
+    assert(change_ring_create(1) == NULL);  /* no room for a run beside the end slot */
+}
+
+TEST(test_ring_drops_when_full) {
+    ChangeRing *ring = change_ring_create(4);
+    ChangeRun run = {0}, end = {.kind = CHANGE_END_OF_GENERATION}, out[4];
+    /* Runs stop one short of capacity; the last slot takes only an end record */
+    for (int i = 0; i < 3; i++)
+        assert(change_ring_push(ring, &run) == 0);
+    assert(change_ring_push(ring, &run) == -1);
+    assert(change_ring_push(ring, &end) == 0);
+    assert(change_ring_push(ring, &end) == -1);
+    assert(change_ring_dropped(ring) == 2);
+    assert(change_ring_pop(ring, out, 1) == 1);
+    assert(change_ring_push(ring, &run) == -1);
+    assert(change_ring_pop(ring, out, 1) == 1);
+    assert(change_ring_push(ring, &run) == 0);
+    change_ring_destroy(ring);
+}
+
+/* ---- Fused kernel ---- */
+
+TEST(test_events_match_plain_kernel) {
+    CellState *curr = calloc(GRID_SIZE, sizeof(CellState));
+    CellState *next = calloc(GRID_SIZE, sizeof(CellState));
+    CellState *plain = calloc(GRID_SIZE, sizeof(CellState));
+    CellState *replay = malloc(GRID_SIZE * sizeof(CellState));
+    ChangeRing *ring = change_ring_create(GRID_SIZE + 1);
+    ChangeRun *runs = malloc((GRID_SIZE + 1) * sizeof(ChangeRun));
+    LifeRule highlife;
+    life_rule_parse(&highlife, "B36/S23");
+    srand(48);
+    randomize_grid(curr, 3);
+
+    for (uint32_t g = 1; g <= 20; g++) {
+        const LifeRule *rule = g % 2 ? &LIFE_RULE_CONWAY : &highlife;
+        compute_new_generation_rule(curr, plain, rule);
+        compute_new_generation_events(curr, next, rule, ring, g);
+        assert(memcmp(next, plain, GRID_SIZE * sizeof(CellState)) == 0);
+
+        memcpy(replay, curr, GRID_SIZE * sizeof(CellState));
+        size_t n = change_ring_pop(ring, runs, GRID_SIZE + 1);
+        assert(apply_runs(replay, runs, n, g) == 0);
+        assert(memcmp(replay, next, GRID_SIZE * sizeof(CellState)) == 0);
+        memcpy(curr, next, GRID_SIZE * sizeof(CellState));
+    }
+    free(curr);
+    free(next);
+    free(plain);
+    free(replay);
+    free(runs);
+    change_ring_destroy(ring);
+}
+
+TEST(test_runs_are_packed_per_row) {
+    CellState *curr = calloc(GRID_SIZE, sizeof(CellState));
+    CellState *next = calloc(GRID_SIZE, sizeof(CellState));
+    ChangeRing *ring = change_ring_create(16);
+    ChangeRun runs[16];
+    /* Horizontal blinker at (9..11, 10): dies at both ends, births above and below. */
+    set_cell(curr, 9, 10, ALIVE);
+    set_cell(curr, 10, 10, ALIVE);
+    set_cell(curr, 11, 10, ALIVE);
+    compute_new_generation_events(curr, next, &LIFE_RULE_CONWAY, ring, 1);
+    assert(change_ring_pop(ring, runs, 16) == 5);
+    assert(runs[0].y == 9 && runs[0].x == 10 && runs[0].length == 1 && runs[0].kind == CHANGE_BIRTH);
+    assert(runs[1].y == 10 && runs[1].x == 9 && runs[1].kind == CHANGE_DEATH);
+    assert(runs[2].y == 10 && runs[2].x == 11 && runs[2].kind == CHANGE_DEATH);
+    assert(runs[3].y == 11 && runs[3].kind == CHANGE_BIRTH);
+    assert(runs[4].kind == CHANGE_END_OF_GENERATION && runs[4].length == 0);
+
+    /* A full row of births becomes one run per row. */
+    memset(curr, 0, GRID_SIZE * sizeof(CellState));
+    for (int x = 0; x < GRID_COLS; x++)
+        set_cell(curr, x, 40, ALIVE);
+    compute_new_generation_events(curr, next, &LIFE_RULE_CONWAY, ring, 2);
+    assert(change_ring_pop(ring, runs, 16) == 3);
+    assert(runs[0].y == 39 && runs[0].x == 0 && runs[0].length == GRID_COLS && runs[0].kind == CHANGE_BIRTH);
+    assert(runs[1].y == 41 && runs[1].x == 0 && runs[1].length == GRID_COLS && runs[1].kind == CHANGE_BIRTH);
+    free(curr);
+    free(next);
+    change_ring_destroy(ring);
+}
+
+TEST(test_end_record_counts_drops) {
+    CellState *curr = calloc(GRID_SIZE, sizeof(CellState));
+    CellState *next = calloc(GRID_SIZE, sizeof(CellState));
+    ChangeRing *ring = change_ring_create(4);
+    ChangeRun runs[4];
+    /* Seven isolated cells die: three runs fit beside the reserved end slot */
+    for (int i = 0; i < 7; i++)
+        set_cell(curr, 10 * i, 10 * i, ALIVE);
+    compute_new_generation_events(curr, next, &LIFE_RULE_CONWAY, ring, 1);
+    assert(change_ring_pop(ring, runs, 4) == 4);
+    assert(change_ring_dropped(ring) == 4);
+    assert(runs[3].kind == CHANGE_END_OF_GENERATION && runs[3].length == 4);
+    free(curr);
+    free(next);
+    change_ring_destroy(ring);
+}
+
+/* ---- Concurrent consumer ---- */
+
+typedef struct {
+    ChangeRing *ring;
+    CellState *grid;
+    int generations_seen;
+} Consumer;
+
+static void *consumer_main(void *arg) {
+    Consumer *c = arg;
+    ChangeRun *runs = malloc(GRID_SIZE * sizeof(ChangeRun));
+    size_t pending = 0;
+    while (c->generations_seen < STREAM_GENERATIONS) {
+        size_t n = change_ring_pop(c->ring, runs + pending, 1);
+        if (n == 0)
+            continue;
+        pending++;
+        if (runs[pending - 1].kind == CHANGE_END_OF_GENERATION) {
+            apply_runs(c->grid, runs, pending, (uint32_t)c->generations_seen + 1);
+            c->generations_seen++;
+            pending = 0;
+        }
+    }
+    free(runs);
+    return NULL;
+}
+
+TEST(test_consumer_thread_reconstructs_grid) {
+    CellState *curr = calloc(GRID_SIZE, sizeof(CellState));
+    CellState *next = calloc(GRID_SIZE, sizeof(CellState));
+    Consumer consumer = {change_ring_create(1 << 20), calloc(GRID_SIZE, sizeof(CellState)), 0};
+    pthread_t thread;
+    srand(49);
+    randomize_grid(curr, 4);
+    memcpy(consumer.grid, curr, GRID_SIZE * sizeof(CellState));
+
+    pthread_create(&thread, NULL, consumer_main, &consumer);
+    for (uint32_t g = 1; g <= STREAM_GENERATIONS; g++) {
+        compute_new_generation_events(curr, next, &LIFE_RULE_CONWAY, consumer.ring, g);
+        CellState *t = curr;
+        curr = next;
+        next = t;
+    }
+    pthread_join(thread, NULL);
+    assert(change_ring_dropped(consumer.ring) == 0);
+    assert(memcmp(consumer.grid, curr, GRID_SIZE * sizeof(CellState)) == 0);
+    free(curr);
+    free(next);
+    free(consumer.grid);
+    change_ring_destroy(consumer.ring);
+}
+
+int main(void) {
+    printf("Running change ring tests (C)...\n\n");
+
+    printf("Ring tests:\n");
+    RUN_TEST(test_ring_fifo_and_wraparound);
+    RUN_TEST(test_ring_drops_when_full);
+
+    printf("\nKernel tests:\n");
+    RUN_TEST(test_events_match_plain_kernel);
+    RUN_TEST(test_runs_are_packed_per_row);
+    RUN_TEST(test_end_record_counts_drops);
+
+    printf("\nConcurrency tests:\n");
+    RUN_TEST(test_consumer_thread_reconstructs_grid);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/*
+ * Tests for the bit-parallel elementary cellular automaton
+ * Compile: make test_eca
+ * Run: ./test_eca
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "eca.h"
+#include "parallel.h"
+#include "random_fill.h"
+
+static void reference_step(uint8_t rule, const uint8_t *curr, uint8_t *next, int width) {
+    for (int x = 0; x < width; x++) {
+        int l = curr[(x + width - 1) % width], c = curr[x], r = curr[(x + 1) % width];
+        next[x] = (rule >> (l << 2 | c << 1 | r)) & 1;
+    }
+}
+
+static void check_rule(uint8_t rule, int width, int generations) {
+    Eca eca;
+    assert(eca_init(&eca, width, rule) == 0);
+    uint8_t *ref = malloc(width), *tmp = malloc(width);
+    for (int x = 0; x < width; x++) {
+        ref[x] = rand() % 2;
+        eca_set(&eca, x, ref[x] ? ALIVE : DEAD);
+    }
+    for (int gen = 0; gen < generations; gen++) {
+        eca_step(&eca);
+        reference_step(rule, ref, tmp, width);
+        memcpy(ref, tmp, width);
+        for (int x = 0; x < width; x++)
+            assert(eca_get(&eca, x) == (ref[x] ? ALIVE : DEAD));
+    }
+    assert(eca.generation == generations);
+    eca_free(&eca);
+    free(ref); free(tmp);
+}
+
+TEST(test_parse) {
+    uint8_t rule;
+    assert(eca_rule_parse(&rule, "W30") == 0 && rule == 30);
+    assert(eca_rule_parse(&rule, "w110") == 0 && rule == 110);
+    assert(eca_rule_parse(&rule, "184") == 0 && rule == 184);
+    assert(eca_rule_parse(&rule, "W256") == -1);
+    assert(eca_rule_parse(&rule, "W") == -1);
+    assert(eca_rule_parse(&rule, "W-1") == -1);
+    assert(eca_rule_parse(&rule, "B3/S23") == -1);
+}
+
+TEST(test_all_rules_match_reference) {
+    srand(1);
+    for (int rule = 0; rule < 256; rule++) {
+        check_rule((uint8_t)rule, 64, 3);
+        check_rule((uint8_t)rule, 150, 3);
+    }
+}
+
+TEST(test_word_boundaries) {
+    int widths[] = {1, 2, 63, 65, 127, 128, 129, 300};
+    for (int i = 0; i < (int)(sizeof(widths) / sizeof(widths[0])); i++) {
+        check_rule(30, widths[i], 40);
+        check_rule(110, widths[i], 40);
+    }
+}
+
+TEST(test_rule_90_single_seed) {
+    /* Rule 90 from one cell draws Pascal's triangle mod 2 */
+    Eca eca;
+    assert(eca_init(&eca, 101, 90) == 0);
+    eca_seed_center(&eca);
+    eca_run(&eca, 8);
+    for (int x = 0; x < 101; x++) {
+        int d = x - 50;
+        int alive = d == -8 || d == 8;
+        assert(eca_get(&eca, x) == (alive ? ALIVE : DEAD));
+    }
+    eca_free(&eca);
+}
+
+TEST(test_diagram_rows_are_generations) {
+    Eca eca, check;
+    CellState grid[20 * 12], row[20];
+    assert(eca_init(&eca, 16, 30) == 0);
+    assert(eca_init(&check, 16, 30) == 0);
+    eca_seed_center(&eca);
+    eca_seed_center(&check);
+
+    eca_diagram(&eca, grid, 20, 12);
+    for (int y = 0; y < 12; y++) {
+        eca_store_row(&check, row, 20);
+        assert(memcmp(grid + y * 20, row, sizeof(row)) == 0);
+        for (int x = 16; x < 20; x++)
+            assert(grid[y * 20 + x] == DEAD);
+        eca_step(&check);
+    }
+
+    eca_scroll(&eca, grid, 20, 12);
+    eca_store_row(&check, row, 20);
+    assert(memcmp(grid + 11 * 20, row, sizeof(row)) == 0);
+    assert(eca.generation == 12);
+    eca_free(&eca);
+    eca_free(&check);
+}
+
+TEST(test_randomize_is_seeded) {
+    /* Cell x is cell x of random_fill, whatever the thread count */
+    Eca eca;
+    CellState row[300];
+    assert(eca_init(&eca, 300, 30) == 0);
+    random_fill(row, 300, 0.5, 9);
+    for (int threads = 1; threads <= 4; threads += 3) {
+        parallel_set_thread_count(threads);
+        assert(eca_randomize(&eca, 0.5, 9) == 0);
+        for (int x = 0; x < 300; x++)
+            assert(eca_get(&eca, x) == row[x]);
+    }
+    parallel_set_thread_count(0);
+    eca_free(&eca);
+}
+
+int main(void) {
+    printf("Running elementary CA tests (C)...\n\n");
+
+    printf("Parsing tests:\n");
+    RUN_TEST(test_parse);
+
+    printf("\nEngine tests:\n");
+    RUN_TEST(test_all_rules_match_reference);
+    RUN_TEST(test_word_boundaries);
+    RUN_TEST(test_rule_90_single_seed);
+    RUN_TEST(test_diagram_rows_are_generations);
+    RUN_TEST(test_randomize_is_seeded);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
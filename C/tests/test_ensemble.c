@@ -0,0 +1,156 @@
+/*
+ * Tests for the interleaved ensemble engine
+ * Compile: make test_ensemble
+ * Run: ./test_ensemble
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "ensemble.h"
+
+#define COLS 16
+#define ROWS 16
+#define CELLS (COLS * ROWS)
+
+/* Straightforward reference on a COLS x ROWS torus */
+static void reference_step(const CellState *curr, CellState *next, const LifeRule *rule) {
+    for (int y = 0; y < ROWS; y++) {
+        for (int x = 0; x < COLS; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                    if (dx || dy)
+                        n += curr[((y + dy + ROWS) % ROWS) * COLS + (x + dx + COLS) % COLS] == ALIVE;
+            uint16_t mask = curr[y * COLS + x] == ALIVE ? rule->survive : rule->birth;
+            next[y * COLS + x] = (mask >> n) & 1 ? ALIVE : DEAD;
+        }
+    }
+}
+
+static void random_board(CellState *grid, unsigned seed) {
+    srand(seed);
+    for (int i = 0; i < CELLS; i++)
+        grid[i] = rand() % 3 == 0 ? ALIVE : DEAD;
+}
+
+static void check_against_reference(const char *rulestring) {
+    enum { N = 150 };  /* spans three groups, the last one partial */
+    static CellState boards[N][CELLS];
+    CellState out[CELLS], tmp[CELLS];
+    LifeRule rule;
+    Ensemble e;
+    assert(life_rule_parse(&rule, rulestring) == 0);
+    assert(ensemble_init(&e, COLS, ROWS, N) == 0);
+    ensemble_set_rule(&e, &rule);
+    for (int b = 0; b < N; b++) {
+        random_board(boards[b], 1000 + b);
+        ensemble_set_board(&e, b, boards[b]);
+    }
+
+    for (int gen = 0; gen < 40; gen++) {
+        ensemble_step(&e);
+        for (int b = 0; b < N; b++) {
+            if (e.settled_at[b] >= 0 && e.settled_at[b] < e.generation)
+                continue;  /* frozen after settling */
+            reference_step(boards[b], tmp, &rule);
+            memcpy(boards[b], tmp, sizeof(tmp));
+            ensemble_get_board(&e, b, out);
+            assert(memcmp(out, boards[b], sizeof(out)) == 0);
+        }
+    }
+    ensemble_free(&e);
+}
+
+TEST(test_matches_reference_across_lanes) {
+    check_against_reference("B3/S23");
+}
+
+TEST(test_other_rules_match_reference) {
+    check_against_reference("B36/S23");
+    check_against_reference("B3678/S34678");
+    check_against_reference("B1357/S1357");
+}
+
+TEST(test_still_life_settles_immediately) {
+    CellState grid[CELLS] = {DEAD};
+    Ensemble e;
+    assert(ensemble_init(&e, COLS, ROWS, 2) == 0);
+    grid[1 * COLS + 1] = grid[1 * COLS + 2] = grid[2 * COLS + 1] = grid[2 * COLS + 2] = ALIVE;
+    ensemble_set_board(&e, 0, grid);
+
+    /* Board 1 holds a glider and never settles on a torus */
+    memset(grid, 0, sizeof(grid));
+    grid[0 * COLS + 1] = grid[1 * COLS + 2] = grid[2 * COLS + 0] = grid[2 * COLS + 1] = grid[2 * COLS + 2] = ALIVE;
+    ensemble_set_board(&e, 1, grid);
+
+    assert(ensemble_step(&e) == 1);
+    assert(!ensemble_board_active(&e, 0));
+    assert(e.settled_at[0] == 1);
+    assert(ensemble_board_active(&e, 1));
+    assert(ensemble_run(&e, 100) == 100);
+    assert(e.settled_at[1] == -1);
+    ensemble_free(&e);
+}
+
+TEST(test_blinker_settles_as_period_two) {
+    CellState grid[CELLS] = {DEAD};
+    Ensemble e;
+    assert(ensemble_init(&e, COLS, ROWS, 1) == 0);
+    grid[5 * COLS + 4] = grid[5 * COLS + 5] = grid[5 * COLS + 6] = ALIVE;
+    ensemble_set_board(&e, 0, grid);
+
+    assert(ensemble_run(&e, 10) == 2);
+    assert(e.settled_at[0] == 2);
+    assert(e.n_active == 0);
+    ensemble_free(&e);
+}
+
+TEST(test_set_board_reactivates) {
+    CellState grid[CELLS] = {DEAD};
+    Ensemble e;
+    assert(ensemble_init(&e, COLS, ROWS, 1) == 0);
+    ensemble_set_board(&e, 0, grid);
+    assert(ensemble_step(&e) == 0);
+
+    grid[0] = grid[1] = grid[2] = ALIVE;
+    ensemble_set_board(&e, 0, grid);
+    assert(e.n_active == 1);
+    assert(ensemble_board_active(&e, 0));
+    ensemble_free(&e);
+}
+
+TEST(test_set_rule_reactivates_settled_boards) {
+    CellState grid[CELLS] = {DEAD}, out[CELLS];
+    LifeRule rule;
+    Ensemble e;
+    assert(ensemble_init(&e, COLS, ROWS, 1) == 0);
+    grid[1 * COLS + 1] = grid[1 * COLS + 2] = grid[2 * COLS + 1] = grid[2 * COLS + 2] = ALIVE;
+    ensemble_set_board(&e, 0, grid);
+    assert(ensemble_step(&e) == 0);
+    assert(!ensemble_board_active(&e, 0));
+
+    /* Under B3/S2 every block cell has three neighbors and dies. */
+    assert(life_rule_parse(&rule, "B3/S2") == 0);
+    ensemble_set_rule(&e, &rule);
+    assert(ensemble_board_active(&e, 0) && e.n_active == 1 && e.settled_at[0] == -1);
+    ensemble_step(&e);
+    ensemble_get_board(&e, 0, out);
+    memset(grid, 0, sizeof(grid));
+    assert(memcmp(out, grid, sizeof(out)) == 0);
+    ensemble_free(&e);
+}
+
+int main(void) {
+    printf("Running ensemble engine tests (C)...\n\n");
+
+    RUN_TEST(test_matches_reference_across_lanes);
+    RUN_TEST(test_other_rules_match_reference);
+    RUN_TEST(test_still_life_settles_immediately);
+    RUN_TEST(test_blinker_settles_as_period_two);
+    RUN_TEST(test_set_board_reactivates);
+    RUN_TEST(test_set_rule_reactivates_settled_boards);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/*
+ * Tests for the libgameoflife public API, linked against the shared library
+ * Compile: make test_gameoflife
+ * Run: ./test_gameoflife
+ */
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "gameoflife.h"
+
+static void reference_step(const uint8_t *curr, uint8_t *next, int cols, int rows, int b36) {
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                    if (dx || dy)
+                        n += curr[((y + dy + rows) % rows) * cols + (x + dx + cols) % cols];
+            int alive = curr[y * cols + x];
+            next[y * cols + x] = alive ? (n == 2 || n == 3) : (n == 3 || (b36 && n == 6));
+        }
+    }
+}
+
+static void check_engine(GolEngine engine, int cols, int rows, const char *rule, int b36) {
+    GolUniverse *u;
+    assert(gol_create(&u, cols, rows, rule, engine) == GOL_OK);
+    size_t n = (size_t)cols * rows;
+    uint8_t *ref = malloc(n), *tmp = malloc(n), *out = malloc(n);
+    srand(cols + rows);
+    for (size_t i = 0; i < n; i++)
+        ref[i] = rand() % 3 == 0;
+    assert(gol_import(u, ref, n) == GOL_OK);
+
+    for (int round = 0; round < 4; round++) {
+        assert(gol_step(u, 3) == GOL_OK);
+        for (int g = 0; g < 3; g++) {
+            reference_step(ref, tmp, cols, rows, b36);
+            memcpy(ref, tmp, n);
+        }
+        assert(gol_export(u, out, n) == GOL_OK);
+        assert(memcmp(out, ref, n) == 0);
+    }
+
+    GolStats stats;
+    stats.struct_size = sizeof(stats);
+    assert(gol_get_stats(u, &stats) == GOL_OK);
+    uint64_t population = 0;
+    for (size_t i = 0; i < n; i++)
+        population += ref[i];
+    assert(stats.generation == 12 && stats.population == population);
+    assert(stats.cols == cols && stats.rows == rows);
+    free(ref); free(tmp); free(out);
+    gol_destroy(u);
+}
+
+TEST(test_version) {
+    assert(gol_version() == ((GOL_VERSION_MAJOR << 16) | GOL_VERSION_MINOR));
+    assert(strcmp(gol_engine_name(GOL_ENGINE_BITGRID), "bitgrid") == 0);
+    assert(strcmp(gol_status_string(GOL_ERR_INVALID), "invalid argument") == 0);
+}
+
+TEST(test_create_rejects_invalid) {
+    GolUniverse *u = (GolUniverse *)1;
+    assert(gol_create(&u, 0, 10, NULL, GOL_ENGINE_AUTO) == GOL_ERR_INVALID);
+    assert(gol_create(&u, 10, 10, "B3/Sx", GOL_ENGINE_AUTO) == GOL_ERR_INVALID);
+    assert(u == NULL);
+    assert(gol_create(&u, 10, 10, NULL, (GolEngine)42) == GOL_ERR_INVALID);
+    gol_destroy(NULL);
+}
+
+TEST(test_engines_match_reference) {
+    check_engine(GOL_ENGINE_SCALAR, 23, 17, NULL, 0);
+    check_engine(GOL_ENGINE_BITGRID, 70, 9, "B3/S23", 0);
+    check_engine(GOL_ENGINE_AUTO, 64, 5, "B36/S23", 1);
+    check_engine(GOL_ENGINE_JIT, 12, 10, "B36/S23", 1);
+}
+
+TEST(test_switching_engines_keeps_state) {
+    GolUniverse *u;
+    assert(gol_create(&u, 20, 20, NULL, GOL_ENGINE_SCALAR) == GOL_OK);
+    /* glider */
+    gol_set_cell(u, 1, 0, 1);
+    gol_set_cell(u, 2, 1, 1);
+    gol_set_cell(u, 0, 2, 1);
+    gol_set_cell(u, 1, 2, 1);
+    gol_set_cell(u, 2, 2, 1);
+    GolEngine order[] = {GOL_ENGINE_BITGRID, GOL_ENGINE_SCALAR, GOL_ENGINE_AUTO, GOL_ENGINE_SCALAR};
+    for (int i = 0; i < 4; i++) {
+        assert(gol_set_engine(u, order[i]) == GOL_OK);
+        assert(gol_step(u, 4) == GOL_OK);
+    }
+    /* After 16 generations the glider moved 4 cells down and right */
+    assert(gol_get_cell(u, 5, 4) && gol_get_cell(u, 6, 5) && gol_get_cell(u, 4, 6));
+    assert(gol_get_cell(u, 5, 6) && gol_get_cell(u, 6, 6));
+    GolStats stats = {.struct_size = sizeof(stats)};
+    gol_get_stats(u, &stats);
+    assert(stats.population == 5 && stats.engine == GOL_ENGINE_SCALAR);
+    assert(strcmp(stats.rule, "B3/S23") == 0);
+    gol_destroy(u);
+}
+
+TEST(test_jit_recompiles_rule_set_on_another_engine) {
+    /* The kernel is dropped when leaving JIT and rebuilt for the new rule */
+    int cols = 12, rows = 10;
+    size_t n = (size_t)cols * rows;
+    uint8_t ref[120], tmp[120], out[120];
+    srand(7);
+    for (size_t i = 0; i < n; i++)
+        ref[i] = rand() % 3 == 0;
+    GolUniverse *u;
+    assert(gol_create(&u, cols, rows, NULL, GOL_ENGINE_JIT) == GOL_OK);
+    assert(gol_import(u, ref, n) == GOL_OK);
+    assert(gol_set_engine(u, GOL_ENGINE_SCALAR) == GOL_OK);
+    assert(gol_set_rule(u, "B36/S23") == GOL_OK);
+    assert(gol_set_engine(u, GOL_ENGINE_JIT) == GOL_OK);
+    assert(gol_step(u, 3) == GOL_OK);
+    for (int g = 0; g < 3; g++) {
+        reference_step(ref, tmp, cols, rows, 1);
+        memcpy(ref, tmp, n);
+    }
+    assert(gol_export(u, out, n) == GOL_OK);
+    assert(memcmp(out, ref, n) == 0);
+    gol_destroy(u);
+}
+
+TEST(test_stats_respect_struct_size) {
+    /* An older caller that only knows the first fields */
+    GolUniverse *u;
+    assert(gol_create(&u, 8, 8, NULL, GOL_ENGINE_AUTO) == GOL_OK);
+    GolStats stats;
+    memset(&stats, 0x5a, sizeof(stats));
+    stats.struct_size = offsetof(GolStats, generation);
+    assert(gol_get_stats(u, &stats) == GOL_OK);
+    assert(stats.cols == 8 && stats.rows == 8);
+    unsigned char *tail = (unsigned char *)&stats + offsetof(GolStats, generation);
+    assert(tail[0] == 0x5a);
+    stats.struct_size = 0;
+    assert(gol_get_stats(u, &stats) == GOL_ERR_INVALID);
+    gol_destroy(u);
+}
+
+TEST(test_import_export_sizes) {
+    GolUniverse *u;
+    uint8_t cells[16] = {0};
+    assert(gol_create(&u, 4, 4, NULL, GOL_ENGINE_AUTO) == GOL_OK);
+    assert(gol_import(u, cells, 15) == GOL_ERR_INVALID);
+    assert(gol_export(u, cells, 17) == GOL_ERR_INVALID);
+    cells[5] = 7;
+    assert(gol_import(u, cells, 16) == GOL_OK);
+    assert(gol_export(u, cells, 16) == GOL_OK);
+    assert(cells[5] == 1);
+    assert(gol_set_rule(u, "B3/S") == GOL_OK);
+    assert(gol_set_rule(u, "nope") == GOL_ERR_INVALID);
+    gol_destroy(u);
+}
+
+TEST(test_only_api_symbols_exported) {
+    void *lib = dlopen(GOL_LIB_PATH, RTLD_NOW | RTLD_LOCAL);
+    assert(lib != NULL);
+    assert(dlsym(lib, "gol_create") != NULL);
+    assert(dlsym(lib, "gol_step") != NULL);
+    assert(dlsym(lib, "life_rule_parse") == NULL);
+    assert(dlsym(lib, "bitgrid_step") == NULL);
+    assert(dlsym(lib, "compute_new_generation") == NULL);
+    dlclose(lib);
+}
+
+int main(void) {
+    printf("Running libgameoflife tests (C)...\n\n");
+
+    printf("API tests:\n");
+    RUN_TEST(test_version);
+    RUN_TEST(test_create_rejects_invalid);
+    RUN_TEST(test_import_export_sizes);
+    RUN_TEST(test_stats_respect_struct_size);
+
+    printf("\nEngine tests:\n");
+    RUN_TEST(test_engines_match_reference);
+    RUN_TEST(test_switching_engines_keeps_state);
+    RUN_TEST(test_jit_recompiles_rule_set_on_another_engine);
+
+    printf("\nABI tests:\n");
+    RUN_TEST(test_only_api_symbols_exported);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
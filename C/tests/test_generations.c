@@ -0,0 +1,139 @@
+/*
+ * Tests for multi-state Generations rules
+ * Compile: make test_generations
+ * Run: ./test_generations
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "generations.h"
+
+#define COLS 19
+#define ROWS 11
+#define CELLS (COLS * ROWS)
+
+static void reference_step(const uint8_t *curr, uint8_t *next, const GenerationsRule *rule) {
+    for (int y = 0; y < ROWS; y++) {
+        for (int x = 0; x < COLS; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                    if (dx || dy)
+                        n += curr[((y + dy + ROWS) % ROWS) * COLS + (x + dx + COLS) % COLS] == GEN_ALIVE;
+            int s = curr[y * COLS + x], out;
+            if (s == GEN_DEAD)
+                out = (rule->birth >> n) & 1;
+            else if (s == GEN_ALIVE && ((rule->survive >> n) & 1))
+                out = GEN_ALIVE;
+            else
+                out = s + 1 >= rule->n_states ? GEN_DEAD : s + 1;
+            next[y * COLS + x] = (uint8_t)out;
+        }
+    }
+}
+
+TEST(test_parse_forms) {
+    GenerationsRule rule;
+    assert(generations_rule_parse(&rule, "B2/S/C3") == 0);
+    assert(rule.birth == (1 << 2) && rule.survive == 0 && rule.n_states == 3);
+    assert(generations_rule_parse(&rule, "/2/3") == 0);
+    assert(rule.birth == (1 << 2) && rule.survive == 0 && rule.n_states == 3);
+    assert(generations_rule_parse(&rule, "345/2/4") == 0);
+    assert(rule.survive == ((1 << 3) | (1 << 4) | (1 << 5)) && rule.birth == (1 << 2) && rule.n_states == 4);
+    assert(generations_rule_parse(&rule, "b3/s23/g256") == 0);
+    assert(rule.n_states == 256);
+    assert(generations_rule_parse(&rule, "B3/S23") == 0);
+    assert(rule.n_states == 2);
+}
+
+TEST(test_parse_rejects_invalid) {
+    GenerationsRule rule;
+    assert(generations_rule_parse(&rule, "B2/S/C1") != 0);
+    assert(generations_rule_parse(&rule, "B2/S/C257") != 0);
+    assert(generations_rule_parse(&rule, "/2/") != 0);
+    assert(generations_rule_parse(&rule, "B2/C3") != 0);
+    assert(generations_rule_parse(&rule, "B2/S/C3/") != 0);
+}
+
+TEST(test_format) {
+    GenerationsRule rule;
+    char buf[32];
+    assert(generations_rule_parse(&rule, "345/2/4") == 0);
+    generations_rule_format(&rule, buf, sizeof(buf));
+    assert(strcmp(buf, "B2/S345/C4") == 0);
+}
+
+TEST(test_decay_sequence) {
+    uint8_t a[CELLS] = {0}, b[CELLS];
+    GenerationsRule rule;
+    assert(generations_rule_parse(&rule, "B2/S/C4") == 0);
+    a[5 * COLS + 5] = GEN_ALIVE;  /* isolated cell: no births, no survival */
+
+    uint8_t expected[] = {2, 3, 0};
+    for (int i = 0; i < 3; i++) {
+        generations_step(a, b, COLS, ROWS, &rule);
+        assert(b[5 * COLS + 5] == expected[i]);
+        memcpy(a, b, sizeof(a));
+    }
+}
+
+TEST(test_256_states_wrap_to_dead) {
+    uint8_t a[CELLS] = {0}, b[CELLS];
+    GenerationsRule rule;
+    assert(generations_rule_parse(&rule, "B/S/C256") == 0);
+    a[0] = 254;
+    a[1] = 255;
+    generations_step(a, b, COLS, ROWS, &rule);
+    assert(b[0] == 255);
+    assert(b[1] == GEN_DEAD);
+}
+
+TEST(test_dying_cells_are_not_neighbors) {
+    uint8_t a[CELLS] = {0}, b[CELLS];
+    GenerationsRule rule;
+    assert(generations_rule_parse(&rule, "B2/S/C3") == 0);
+    /* Two alive and one dying neighbor: count is two, so (5,5) is born */
+    a[4 * COLS + 4] = GEN_ALIVE;
+    a[4 * COLS + 6] = GEN_ALIVE;
+    a[6 * COLS + 5] = 2;
+    generations_step(a, b, COLS, ROWS, &rule);
+    assert(b[5 * COLS + 5] == GEN_ALIVE);
+}
+
+TEST(test_matches_reference) {
+    const char *rules[] = {"B2/S/C3", "345/2/4", "B3/S23/C8", "B34/S12/C200", "B3/S23"};
+    for (size_t r = 0; r < sizeof(rules) / sizeof(rules[0]); r++) {
+        uint8_t a[CELLS], b[CELLS], ra[CELLS], rb[CELLS];
+        GenerationsRule rule;
+        assert(generations_rule_parse(&rule, rules[r]) == 0);
+        srand(9 + r);
+        for (int i = 0; i < CELLS; i++)
+            a[i] = ra[i] = (uint8_t)(rand() % rule.n_states);
+        for (int gen = 0; gen < 12; gen++) {
+            generations_step(a, b, COLS, ROWS, &rule);
+            reference_step(ra, rb, &rule);
+            assert(memcmp(b, rb, sizeof(b)) == 0);
+            memcpy(a, b, sizeof(a));
+            memcpy(ra, rb, sizeof(ra));
+        }
+    }
+}
+
+int main(void) {
+    printf("Running Generations rule tests (C)...\n\n");
+
+    printf("Parsing tests:\n");
+    RUN_TEST(test_parse_forms);
+    RUN_TEST(test_parse_rejects_invalid);
+    RUN_TEST(test_format);
+
+    printf("\nKernel tests:\n");
+    RUN_TEST(test_decay_sequence);
+    RUN_TEST(test_256_states_wrap_to_dead);
+    RUN_TEST(test_dying_cells_are_not_neighbors);
+    RUN_TEST(test_matches_reference);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+/*
+ * Tests for huge-page backed grid buffers
+ * Compile: make test_grid_alloc
+ * Run: ./test_grid_alloc
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "grid_alloc.h"
+
+static void check_buffer(const GridBuffer *buf, size_t n_cells) {
+    assert(buf->cells != NULL);
+    assert(buf->n_cells == n_cells);
+    assert(buf->bytes >= n_cells * sizeof(CellState));
+    assert((uintptr_t)buf->cells % GRID_ALIGNMENT == 0);
+
+    /* Whole buffer must be writable */
+    for (size_t i = 0; i < n_cells; i++)
+        buf->cells[i] = (i % 3 == 0) ? ALIVE : DEAD;
+    assert(buf->cells[0] == ALIVE);
+    assert(buf->cells[n_cells - 1] == ((n_cells - 1) % 3 == 0 ? ALIVE : DEAD));
+}
+
+TEST(test_heap_backing) {
+    GridBuffer buf;
+    assert(grid_buffer_alloc(&buf, 1000, GRID_BACKING_HEAP) == 0);
+    assert(buf.backing == GRID_BACKING_HEAP);
+    check_buffer(&buf, 1000);
+    grid_buffer_free(&buf);
+    assert(buf.cells == NULL);
+}
+
+TEST(test_thp_backing_is_huge_page_aligned) {
+    GridBuffer buf;
+    size_t n = 3 * HUGE_PAGE_SIZE / sizeof(CellState) + 17;
+    assert(grid_buffer_alloc(&buf, n, GRID_BACKING_THP) == 0);
+    assert(buf.backing == GRID_BACKING_THP || buf.backing == GRID_BACKING_HEAP);
+    if (buf.backing == GRID_BACKING_THP) {
+        assert((uintptr_t)buf.cells % HUGE_PAGE_SIZE == 0);
+        assert(buf.bytes % HUGE_PAGE_SIZE == 0);
+    }
+    check_buffer(&buf, n);
+    grid_buffer_free(&buf);
+}
+
+TEST(test_hugetlb_falls_back) {
+    GridBuffer buf;
+    size_t n = 1024 * 1024;
+    /* Succeeds whether or not the system has reserved huge pages */
+    assert(grid_buffer_alloc(&buf, n, GRID_BACKING_HUGETLB) == 0);
+    check_buffer(&buf, n);
+    assert(strcmp(grid_backing_name(buf.backing), "unknown") != 0);
+    printf("[%s] ", grid_backing_name(buf.backing));
+    grid_buffer_free(&buf);
+}
+
+TEST(test_zero_cells_rejected) {
+    GridBuffer buf;
+    assert(grid_buffer_alloc(&buf, 0, GRID_BACKING_HEAP) != 0);
+    assert(buf.cells == NULL);
+    grid_buffer_free(&buf);
+}
+
+int main(void) {
+    printf("Running grid allocation tests (C)...\n\n");
+
+    RUN_TEST(test_heap_backing);
+    RUN_TEST(test_thp_backing_is_huge_page_aligned);
+    RUN_TEST(test_hugetlb_falls_back);
+    RUN_TEST(test_zero_cells_rejected);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
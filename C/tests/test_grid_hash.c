@@ -0,0 +1,172 @@
+/*
+ * Tests for grid hashing, equality and diff counts
+ * Compile: make test_grid_hash
+ * Run: ./test_grid_hash
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "grid_hash.h"
+
+static CellState *random_grid(int cols, int rows, unsigned seed) {
+    CellState *grid = malloc((size_t)cols * rows * sizeof(CellState));
+    srand(seed);
+    for (int i = 0; i < cols * rows; i++)
+        grid[i] = rand() % 3 ? DEAD : ALIVE;
+    return grid;
+}
+
+/* ---- Hashes ---- */
+
+TEST(test_known_answers) {
+    /* Fixed values: the hash must not change across platforms or releases. */
+    CellState grid[3 * 70] = {DEAD};
+    GridHash128 empty = grid_hash128(grid, 70, 3);
+    for (int i = 0; i < 3 * 70; i += 7)
+        grid[i] = ALIVE;
+    GridHash128 sparse = grid_hash128(grid, 70, 3);
+    assert(empty.lo == 0xff394526df6a5e38ULL && empty.hi == 0x0abfe28cc998c94dULL);
+    assert(sparse.lo == 0xd8d1d41b528559d3ULL && sparse.hi == 0x328d2bcf8cff8bd3ULL);
+    assert(grid_hash64(grid, 70, 3) == sparse.lo);
+}
+
+TEST(test_hash_depends_on_cells_and_shape) {
+    CellState *grid = random_grid(50, 40, 1);
+    GridHash128 base = grid_hash128(grid, 50, 40);
+    assert(grid_hash_equal(base, grid_hash128(grid, 50, 40)));
+
+    /* Flipping any single cell changes both halves. */
+    for (int i = 0; i < 50 * 40; i += 13) {
+        grid[i] = !grid[i];
+        GridHash128 h = grid_hash128(grid, 50, 40);
+        assert(h.lo != base.lo && h.hi != base.hi);
+        grid[i] = !grid[i];
+    }
+    /* Same cells, different shape. */
+    assert(!grid_hash_equal(base, grid_hash128(grid, 40, 50)));
+    /* Swapped rows. */
+    CellState row[50];
+    memcpy(row, grid, sizeof(row));
+    memcpy(grid, grid + 50, sizeof(row));
+    memcpy(grid + 50, row, sizeof(row));
+    assert(!grid_hash_equal(base, grid_hash128(grid, 50, 40)));
+    free(grid);
+}
+
+TEST(test_nonzero_states_hash_as_alive) {
+    CellState a[10] = {DEAD}, b[10] = {DEAD};
+    a[4] = ALIVE;
+    b[4] = (CellState)7;
+    assert(grid_hash_equal(grid_hash128(a, 10, 1), grid_hash128(b, 10, 1)));
+    /* Comparison uses the same notion of a cell as hashing */
+    assert(grid_equal(a, b, 10) && grid_diff_count(a, b, 10) == 0);
+}
+
+/* ---- Equality and diffs ---- */
+
+TEST(test_equal_and_diff_count) {
+    CellState *a = random_grid(33, 33, 2);
+    CellState *b = malloc(33 * 33 * sizeof(CellState));
+    memcpy(b, a, 33 * 33 * sizeof(CellState));
+    assert(grid_equal(a, b, 33 * 33));
+    assert(grid_diff_count(a, b, 33 * 33) == 0);
+    b[0] = !b[0];
+    b[33 * 33 - 1] = !b[33 * 33 - 1];
+    b[500] = !b[500];
+    assert(!grid_equal(a, b, 33 * 33));
+    assert(grid_diff_count(a, b, 33 * 33) == 3);
+    assert(grid_diff_count(a, b, 33 * 33 - 1) == 2);
+    free(a);
+    free(b);
+}
+
+/* ---- Row hashes ---- */
+
+TEST(test_row_hashes_track_updates) {
+    RowHashes h;
+    CellState *grid = calloc(70 * 20, sizeof(CellState));
+    assert(row_hashes_init(&h, 70, 20) == 0);
+    assert(grid_hash_equal(row_hashes_grid(&h), grid_hash128(grid, 70, 20)));
+
+    for (int i = 0; i < 50; i++) {
+        int y = rand() % 20;
+        grid[y * 70 + rand() % 70] = ALIVE;
+        row_hashes_set(&h, y, grid_row_hash(grid + y * 70, 70));
+        assert(grid_hash_equal(row_hashes_grid(&h), grid_hash128(grid, 70, 20)));
+    }
+    row_hashes_compute(&h, grid);
+    assert(grid_hash_equal(row_hashes_grid(&h), grid_hash128(grid, 70, 20)));
+    row_hashes_free(&h);
+    assert(row_hashes_init(&h, 0, 5) == -1);
+    free(grid);
+}
+
+TEST(test_hashed_generation_pass) {
+    RowHashes h;
+    CellState *curr = random_grid(GRID_COLS, GRID_ROWS, 3);
+    CellState *next = malloc(GRID_SIZE * sizeof(CellState));
+    CellState *plain = malloc(GRID_SIZE * sizeof(CellState));
+    row_hashes_init(&h, GRID_COLS, GRID_ROWS);
+    row_hashes_compute(&h, curr);
+
+    for (int g = 0; g < 30; g++) {
+        compute_new_generation_rule(curr, plain, &LIFE_RULE_CONWAY);
+        assert(compute_new_generation_hashed(curr, next, &LIFE_RULE_CONWAY, &h) == 0);
+        assert(grid_equal(next, plain, GRID_SIZE));
+        assert(grid_hash_equal(row_hashes_grid(&h), grid_hash128(next, GRID_COLS, GRID_ROWS)));
+        CellState *t = curr;
+        curr = next;
+        next = t;
+    }
+    row_hashes_free(&h);
+    /* Hashes for a different grid size are refused */
+    row_hashes_init(&h, GRID_COLS, GRID_ROWS - 1);
+    assert(compute_new_generation_hashed(curr, next, &LIFE_RULE_CONWAY, &h) == -1);
+    row_hashes_free(&h);
+    free(curr);
+    free(next);
+    free(plain);
+}
+
+TEST(test_nonzero_states_step_as_alive) {
+    /* A grid using 7 for alive steps exactly like the same grid using ALIVE */
+    RowHashes h;
+    CellState *ones = random_grid(GRID_COLS, GRID_ROWS, 4);
+    CellState *sevens = malloc(GRID_SIZE * sizeof(CellState));
+    CellState *next_ones = malloc(GRID_SIZE * sizeof(CellState));
+    CellState *next_sevens = malloc(GRID_SIZE * sizeof(CellState));
+    for (int i = 0; i < GRID_SIZE; i++)
+        sevens[i] = ones[i] ? (CellState)7 : DEAD;
+    assert(row_hashes_init(&h, GRID_COLS, GRID_ROWS) == 0);
+    row_hashes_compute(&h, sevens);
+    compute_new_generation_rule(ones, next_ones, &LIFE_RULE_CONWAY);
+    assert(compute_new_generation_hashed(sevens, next_sevens, &LIFE_RULE_CONWAY, &h) == 0);
+    assert(memcmp(next_ones, next_sevens, GRID_SIZE * sizeof(CellState)) == 0);
+    assert(grid_hash_equal(row_hashes_grid(&h), grid_hash128(next_ones, GRID_COLS, GRID_ROWS)));
+    row_hashes_free(&h);
+    free(ones);
+    free(sevens);
+    free(next_ones);
+    free(next_sevens);
+}
+
+int main(void) {
+    printf("Running grid hash tests (C)...\n\n");
+
+    printf("Hash tests:\n");
+    RUN_TEST(test_known_answers);
+    RUN_TEST(test_hash_depends_on_cells_and_shape);
+    RUN_TEST(test_nonzero_states_hash_as_alive);
+
+    printf("\nComparison tests:\n");
+    RUN_TEST(test_equal_and_diff_count);
+
+    printf("\nRow hash tests:\n");
+    RUN_TEST(test_row_hashes_track_updates);
+    RUN_TEST(test_hashed_generation_pass);
+    RUN_TEST(test_nonzero_states_step_as_alive);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/*
+ * Tests for the per-thread grid buffer pool
+ * Compile: make test_grid_pool
+ * Run: ./test_grid_pool
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "grid_pool.h"
+
+static int is_zero(const GridBuffer *buf) {
+    for (size_t i = 0; i < buf->n_cells; i++)
+        if (buf->cells[i] != DEAD)
+            return 0;
+    return 1;
+}
+
+TEST(test_reuses_buffer_of_same_size) {
+    GridBuffer a, b;
+    GridPoolStats stats;
+    grid_pool_trim();
+    assert(grid_pool_alloc(&a, 5000) == 0);
+    assert(is_zero(&a) && (uintptr_t)a.cells % GRID_ALIGNMENT == 0);
+    CellState *cells = a.cells;
+    memset(a.cells, ALIVE, 5000 * sizeof(CellState));
+    grid_pool_free(&a);
+    assert(a.cells == NULL);
+
+    grid_pool_stats(&stats);
+    assert(stats.cached == 1 && stats.cached_bytes >= 5000 * sizeof(CellState));
+    assert(grid_pool_alloc(&b, 5000) == 0);
+    assert(b.cells == cells && b.n_cells == 5000 && is_zero(&b));
+    grid_pool_stats(&stats);
+    assert(stats.hits == 1 && stats.misses == 1 && stats.cached == 0);
+    grid_pool_free(&b);
+    grid_pool_trim();
+}
+
+TEST(test_sizes_do_not_mix) {
+    GridBuffer small, large;
+    GridPoolStats stats;
+    grid_pool_trim();
+    assert(grid_pool_alloc(&small, 100) == 0);
+    grid_pool_free(&small);
+    assert(grid_pool_alloc(&large, 101) == 0);
+    assert(large.n_cells == 101);
+    grid_pool_free(&large);
+    grid_pool_stats(&stats);
+    assert(stats.cached == 2);
+    grid_pool_trim();
+    grid_pool_stats(&stats);
+    assert(stats.cached == 0 && stats.cached_bytes == 0);
+}
+
+TEST(test_depth_and_class_limits) {
+    GridBuffer bufs[GRID_POOL_DEPTH + 2];
+    GridPoolStats stats;
+    grid_pool_trim();
+    for (int i = 0; i < GRID_POOL_DEPTH + 2; i++)
+        assert(grid_pool_alloc(&bufs[i], 64) == 0);
+    for (int i = 0; i < GRID_POOL_DEPTH + 2; i++)
+        grid_pool_free(&bufs[i]);
+    grid_pool_stats(&stats);
+    assert(stats.cached == GRID_POOL_DEPTH);
+
+    /* New sizes evict the least recently used class, here the 64-cell one. */
+    for (int i = 0; i < GRID_POOL_CLASSES; i++) {
+        assert(grid_pool_alloc(&bufs[0], 1000 + i) == 0);
+        grid_pool_free(&bufs[0]);
+    }
+    grid_pool_stats(&stats);
+    assert(stats.cached == GRID_POOL_CLASSES);
+    uint64_t misses = stats.misses;
+    assert(grid_pool_alloc(&bufs[0], 1001) == 0);
+    grid_pool_stats(&stats);
+    assert(stats.misses == misses);
+    grid_pool_free(&bufs[0]);
+    grid_pool_trim();
+}
+
+TEST(test_large_grids_use_huge_page_backing) {
+    GridBuffer buf;
+    size_t n = HUGE_PAGE_SIZE / sizeof(CellState) + 1;
+    grid_pool_trim();
+    assert(grid_pool_alloc(&buf, n) == 0);
+    assert(buf.backing != GRID_BACKING_HEAP || is_zero(&buf));
+    buf.cells[n - 1] = ALIVE;
+    CellState *cells = buf.cells;
+    grid_pool_free(&buf);
+    assert(grid_pool_alloc(&buf, n) == 0);
+    assert(buf.cells == cells && buf.cells[n - 1] == DEAD);
+    grid_pool_free(&buf);
+    grid_pool_trim();
+}
+
+static void *other_thread(void *arg) {
+    GridBuffer *shared = arg;
+    GridPoolStats stats;
+    GridBuffer mine;
+    /* The main thread's cached buffer is not visible here. */
+    assert(grid_pool_alloc(&mine, 777) == 0);
+    grid_pool_stats(&stats);
+    assert(stats.hits == 0 && stats.misses == 1);
+    grid_pool_free(&mine);
+    /* A buffer from another thread lands in this thread's arena. */
+    grid_pool_free(shared);
+    grid_pool_stats(&stats);
+    assert(stats.cached == 2);
+    return NULL;  /* the arena is trimmed at thread exit */
+}
+
+TEST(test_arenas_are_per_thread) {
+    GridBuffer cached, shared;
+    pthread_t thread;
+    grid_pool_trim();
+    assert(grid_pool_alloc(&cached, 777) == 0);
+    grid_pool_free(&cached);
+    assert(grid_pool_alloc(&shared, 888) == 0);
+    pthread_create(&thread, NULL, other_thread, &shared);
+    pthread_join(thread, NULL);
+
+    GridPoolStats stats;
+    grid_pool_stats(&stats);
+    assert(stats.cached == 1);
+    grid_pool_trim();
+}
+
+int main(void) {
+    printf("Running grid pool tests (C)...\n\n");
+
+    printf("Arena tests:\n");
+    RUN_TEST(test_reuses_buffer_of_same_size);
+    RUN_TEST(test_sizes_do_not_mix);
+    RUN_TEST(test_depth_and_class_limits);
+    RUN_TEST(test_large_grids_use_huge_page_backing);
+    RUN_TEST(test_arenas_are_per_thread);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
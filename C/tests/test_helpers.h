@@ -0,0 +1,33 @@
+/*
+ * Minimal test harness shared by the module test programs.
+ * Mirrors the TEST/RUN_TEST macros of test_game.c.
+ */
+
+#ifndef TEST_HELPERS_H
+#define TEST_HELPERS_H
+
+#include <stdio.h>
+
+/* Tests call the code under test inside assert(), so keep it in release
+ * builds (-DNDEBUG) too. */
+#undef NDEBUG
+#include <assert.h>
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST(name) void name(void)
+#define RUN_TEST(name) do { \
+    printf("  %s... ", #name); \
+    tests_run++; \
+    name(); \
+    tests_passed++; \
+    printf("PASSED\n"); \
+} while(0)
+
+#define TEST_SUMMARY() do { \
+    printf("\n========================================\n"); \
+    printf("Results: %d/%d tests passed\n", tests_passed, tests_run); \
+} while(0)
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Tests for isotropic non-totalistic (Hensel notation) rules
+ * Compile: make test_hensel
+ * Run: ./test_hensel
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "hensel.h"
+
+#define COLS 23
+#define ROWS 17
+#define CELLS (COLS * ROWS)
+
+/* Builds an index from a 3x3 picture, top row first */
+static int picture(const char *rows) {
+    int index = 0;
+    for (; *rows; rows++) {
+        if (*rows == 'x' || *rows == '.')
+            index = (index << 1) | (*rows == 'x');
+    }
+    return index;
+}
+
+TEST(test_totalistic_rule_matches_life_table) {
+    const char *rules[] = {"B3/S23", "B36/S23", "B3678/S34678", "B/S"};
+    for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+        HenselRule parsed, converted;
+        LifeRule life;
+        assert(hensel_rule_parse(&parsed, rules[i]) == 0);
+        assert(life_rule_parse(&life, rules[i]) == 0);
+        hensel_rule_from_life(&converted, &life);
+        assert(memcmp(parsed.table, converted.table, HENSEL_TABLE_SIZE) == 0);
+    }
+}
+
+TEST(test_letters_partition_each_count) {
+    /* For every count, the lettered subrules are disjoint and cover the count */
+    const char *letters[9] = {"", "ce", "cekain", "cekainyqjr", "cekainyqjrtwz", "cekainyqjr", "cekain", "ce", ""};
+    for (int n = 1; n <= 7; n++) {
+        int covered[HENSEL_TABLE_SIZE] = {0};
+        for (const char *l = letters[n]; *l; l++) {
+            char rs[16];
+            HenselRule rule;
+            snprintf(rs, sizeof(rs), "B%d%c/S", n, *l);
+            assert(hensel_rule_parse(&rule, rs) == 0);
+            for (int i = 0; i < HENSEL_TABLE_SIZE; i++)
+                covered[i] += rule.table[i];
+        }
+        for (int i = 0; i < HENSEL_TABLE_SIZE; i++) {
+            int center = (i >> 4) & 1;
+            int count = __builtin_popcount(i & ~(1 << 4));
+            assert(covered[i] == (!center && count == n));
+        }
+    }
+}
+
+TEST(test_known_neighborhoods) {
+    HenselRule rule;
+    assert(hensel_rule_parse(&rule, "B2-a/S12") == 0);
+    assert(rule.table[picture("xx. ... ...")] == 0);  /* 2a excluded */
+    assert(rule.table[picture("x.x ... ...")] == 1);  /* 2c */
+    assert(rule.table[picture(".x. ... .x.")] == 1);  /* 2i */
+    assert(rule.table[picture("... .x. ..x")] == 1);  /* S1 */
+    assert(rule.table[picture("... xxx ...")] == 1);  /* S2 */
+
+    assert(hensel_rule_parse(&rule, "B3/S2-i34q") == 0);
+    assert(rule.table[picture(".x. .x. .x.")] == 0);  /* 2i excluded */
+    assert(rule.table[picture(".x. .xx ...")] == 1);  /* 2e */
+    assert(rule.table[picture("x.. .x. ..x")] == 1);  /* 2n */
+    assert(rule.table[picture("xx. .x. ..x")] == 1);  /* 3q */
+    assert(rule.table[picture("xx. .xx ...")] == 1);  /* 3j */
+    assert(rule.table[picture("xx. xx. ..x")] == 1);  /* 4q */
+    assert(rule.table[picture("xx. .x. .xx")] == 0);  /* 4z */
+}
+
+TEST(test_tables_are_isotropic) {
+    const char *rules[] = {"B2ci3ai4c8/S02ae3eijkq4iz5ar6i7e", "B2-a/S12", "B3/S2-i34q", "B4-tw5k/S3n4j6-c"};
+    for (size_t r = 0; r < sizeof(rules) / sizeof(rules[0]); r++) {
+        HenselRule rule;
+        assert(hensel_rule_parse(&rule, rules[r]) == 0);
+        for (int i = 0; i < HENSEL_TABLE_SIZE; i++) {
+            int cell[3][3], rot = 0, mir = 0;
+            for (int k = 0; k < 9; k++)
+                cell[k / 3][k % 3] = (i >> (8 - k)) & 1;
+            for (int yy = 0; yy < 3; yy++) {
+                for (int xx = 0; xx < 3; xx++) {
+                    rot = (rot << 1) | cell[2 - xx][yy];
+                    mir = (mir << 1) | cell[yy][2 - xx];
+                }
+            }
+            assert(rule.table[i] == rule.table[rot]);
+            assert(rule.table[i] == rule.table[mir]);
+        }
+    }
+}
+
+TEST(test_parse_rejects_invalid) {
+    HenselRule rule;
+    assert(hensel_rule_parse(&rule, "B2x/S23") != 0);   /* no 2x */
+    assert(hensel_rule_parse(&rule, "B1k/S23") != 0);   /* k needs two or more */
+    assert(hensel_rule_parse(&rule, "B8c/S23") != 0);
+    assert(hensel_rule_parse(&rule, "B2-/S23") != 0);
+    assert(hensel_rule_parse(&rule, "B3") != 0);
+}
+
+static void reference_step(const CellState *curr, CellState *next, const HenselRule *rule) {
+    for (int y = 0; y < ROWS; y++)
+        for (int x = 0; x < COLS; x++)
+            next[y * COLS + x] = (CellState)rule->table[hensel_index(curr, COLS, ROWS, x, y)];
+}
+
+TEST(test_sliding_kernel_matches_gather) {
+    CellState a[CELLS], b[CELLS], ra[CELLS], rb[CELLS];
+    HenselRule rule;
+    assert(hensel_rule_parse(&rule, "B2ci3ai4c8/S02ae3eijkq4iz5ar6i7e") == 0);
+    srand(5);
+    for (int i = 0; i < CELLS; i++)
+        a[i] = ra[i] = rand() % 2 ? ALIVE : DEAD;
+
+    for (int gen = 0; gen < 10; gen++) {
+        hensel_step(a, b, COLS, ROWS, &rule);
+        reference_step(ra, rb, &rule);
+        assert(memcmp(b, rb, sizeof(b)) == 0);
+        memcpy(a, b, sizeof(a));
+        memcpy(ra, rb, sizeof(ra));
+    }
+}
+
+TEST(test_conway_blinker) {
+    CellState grid[CELLS] = {DEAD}, next[CELLS];
+    HenselRule rule;
+    assert(hensel_rule_parse(&rule, "B3/S23") == 0);
+    grid[5 * COLS + 0] = grid[5 * COLS + 1] = grid[5 * COLS + COLS - 1] = ALIVE;  /* across the edge */
+    hensel_step(grid, next, COLS, ROWS, &rule);
+    assert(next[4 * COLS + 0] == ALIVE);
+    assert(next[5 * COLS + 0] == ALIVE);
+    assert(next[6 * COLS + 0] == ALIVE);
+    assert(next[5 * COLS + 1] == DEAD);
+    assert(next[5 * COLS + COLS - 1] == DEAD);
+}
+
+int main(void) {
+    printf("Running Hensel notation tests (C)...\n\n");
+
+    printf("Rule compilation tests:\n");
+    RUN_TEST(test_totalistic_rule_matches_life_table);
+    RUN_TEST(test_letters_partition_each_count);
+    RUN_TEST(test_known_neighborhoods);
+    RUN_TEST(test_tables_are_isotropic);
+    RUN_TEST(test_parse_rejects_invalid);
+
+    printf("\nKernel tests:\n");
+    RUN_TEST(test_sliding_kernel_matches_gather);
+    RUN_TEST(test_conway_blinker);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
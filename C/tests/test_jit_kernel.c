@@ -0,0 +1,192 @@
+/*
+ * Tests for runtime-compiled step kernels
+ * Compile: make test_jit_kernel
+ * Run: ./test_jit_kernel
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "test_helpers.h"
+#include "jit_kernel.h"
+
+static char cache_dir[] = "/tmp/gol-jit-test-XXXXXX";
+
+static void reference_step(const KernelParams *p, const CellState *curr, CellState *next) {
+    for (int y = 0; y < p->rows; y++) {
+        for (int x = 0; x < p->cols; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int nx = x + dx, ny = y + dy;
+                    if (!dx && !dy)
+                        continue;
+                    if (p->boundary == BOUNDARY_TORUS) {
+                        nx = (nx + p->cols) % p->cols;
+                        ny = (ny + p->rows) % p->rows;
+                    } else if (nx < 0 || nx >= p->cols || ny < 0 || ny >= p->rows) {
+                        continue;
+                    }
+                    n += curr[ny * p->stride + nx] == ALIVE;
+                }
+            }
+            CellState self = curr[y * p->stride + x];
+            next[y * p->stride + x] = p->rule.table[LIFE_RULE_INDEX(self, n)] ? ALIVE : DEAD;
+        }
+    }
+}
+
+/* Runs a few generations with the kernel and the reference; padding columns must stay untouched */
+static void check_kernel(const JitKernel *kernel) {
+    const KernelParams *p = &kernel->params;
+    size_t n = (size_t)p->rows * p->stride;
+    CellState *a = malloc(n * sizeof(CellState)), *b = malloc(n * sizeof(CellState));
+    CellState *ra = malloc(n * sizeof(CellState)), *rb = malloc(n * sizeof(CellState));
+
+    srand(p->cols * 17 + p->rows);
+    for (size_t i = 0; i < n; i++) {
+        int padding = (int)(i % p->stride) >= p->cols;
+        a[i] = padding ? (CellState)7 : rand() % 3 == 0 ? ALIVE : DEAD;  /* sentinel in the padding */
+        b[i] = rb[i] = (CellState)7;
+    }
+    memcpy(ra, a, n * sizeof(CellState));
+
+    for (int gen = 0; gen < 8; gen++) {
+        jit_kernel_step(kernel, a, b);
+        reference_step(p, ra, rb);
+        for (int y = 0; y < p->rows; y++)
+            assert(memcmp(b + y * p->stride, rb + y * p->stride, p->cols * sizeof(CellState)) == 0);
+        CellState *t = a; a = b; b = t;
+        t = ra; ra = rb; rb = t;
+    }
+    for (int y = 0; y < p->rows; y++)
+        for (int x = p->cols; x < p->stride; x++)
+            assert(a[y * p->stride + x] != DEAD && a[y * p->stride + x] != ALIVE);
+
+    free(a); free(b); free(ra); free(rb);
+}
+
+TEST(test_core_geometry_compiles_and_matches) {
+    KernelParams params;
+    JitKernel kernel;
+    kernel_params_core(&params, &LIFE_RULE_CONWAY);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    assert(kernel.step != NULL);
+    assert(!kernel.cache_hit);
+    check_kernel(&kernel);
+    jit_kernel_free(&kernel);
+}
+
+TEST(test_odd_width_dead_boundary_with_stride) {
+    KernelParams params = {.cols = 37, .rows = 13, .stride = 40, .boundary = BOUNDARY_DEAD};
+    JitKernel kernel;
+    assert(life_rule_parse(&params.rule, "B36/S23") == 0);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    assert(kernel.step != NULL);
+    check_kernel(&kernel);
+    jit_kernel_free(&kernel);
+}
+
+TEST(test_second_load_hits_cache) {
+    KernelParams params;
+    JitKernel kernel;
+    kernel_params_core(&params, &LIFE_RULE_CONWAY);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    assert(kernel.step != NULL);
+    assert(kernel.cache_hit);
+    jit_kernel_free(&kernel);
+}
+
+TEST(test_untrusted_cache_entry_is_rebuilt) {
+    KernelParams params;
+    JitKernel kernel;
+    struct stat st;
+    kernel_params_core(&params, &LIFE_RULE_CONWAY);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    char path[sizeof(kernel.path)];
+    strcpy(path, kernel.path);
+    jit_kernel_free(&kernel);
+
+    /* Writable by others: could have been replaced, so it is not loaded. */
+    assert(chmod(path, 0666) == 0);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    assert(!kernel.cache_hit && kernel.step != NULL);
+    assert(stat(path, &st) == 0 && (st.st_mode & 0077) == 0);
+    jit_kernel_free(&kernel);
+
+    /* A symlink is never followed. */
+    assert(remove(path) == 0 && symlink("/dev/null", path) == 0);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    assert(!kernel.cache_hit && kernel.step != NULL);
+    jit_kernel_free(&kernel);
+}
+
+TEST(test_shared_cache_dir_is_refused) {
+    KernelParams params;
+    JitKernel kernel;
+    char dir[sizeof(cache_dir) + 16];
+    kernel_params_core(&params, &LIFE_RULE_CONWAY);
+    snprintf(dir, sizeof(dir), "%s/shared", cache_dir);
+    assert(mkdir(dir, 0700) == 0 && chmod(dir, 0777) == 0);
+    assert(jit_kernel_init(&kernel, &params, dir) == 0);
+    assert(kernel.step == NULL);
+    check_kernel(&kernel);
+    jit_kernel_free(&kernel);
+
+    /* Nor a symlink to a private directory. */
+    snprintf(dir, sizeof(dir), "%s/link", cache_dir);
+    assert(symlink(cache_dir, dir) == 0);
+    assert(jit_kernel_init(&kernel, &params, dir) == 0);
+    assert(kernel.step == NULL);
+    jit_kernel_free(&kernel);
+}
+
+TEST(test_compiler_failure_falls_back) {
+    KernelParams params = {.cols = 21, .rows = 9, .stride = 21, .boundary = BOUNDARY_TORUS};
+    JitKernel kernel;
+    assert(life_rule_parse(&params.rule, "B3678/S34678") == 0);
+    setenv("GOL_JIT_CC", "/nonexistent/cc", 1);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    unsetenv("GOL_JIT_CC");
+    assert(kernel.step == NULL);
+    check_kernel(&kernel);
+    jit_kernel_free(&kernel);
+
+    /* Core geometry falls back to compute_new_generation_rule */
+    kernel_params_core(&params, &LIFE_RULE_CONWAY);
+    setenv("GOL_JIT_CC", "/nonexistent/cc", 1);
+    assert(jit_kernel_init(&kernel, &params, cache_dir) == 0);
+    unsetenv("GOL_JIT_CC");
+    assert(kernel.step == NULL);
+    check_kernel(&kernel);
+    jit_kernel_free(&kernel);
+}
+
+TEST(test_rejects_invalid_params) {
+    KernelParams params = {.cols = 10, .rows = 10, .stride = 5, .boundary = BOUNDARY_TORUS};
+    JitKernel kernel;
+    params.rule = LIFE_RULE_CONWAY;
+    assert(jit_kernel_init(&kernel, &params, cache_dir) != 0);
+}
+
+int main(void) {
+    printf("Running JIT kernel tests (C)...\n\n");
+    assert(mkdtemp(cache_dir) != NULL);
+
+    RUN_TEST(test_core_geometry_compiles_and_matches);
+    RUN_TEST(test_odd_width_dead_boundary_with_stride);
+    RUN_TEST(test_second_load_hits_cache);
+    RUN_TEST(test_untrusted_cache_entry_is_rebuilt);
+    RUN_TEST(test_shared_cache_dir_is_refused);
+    RUN_TEST(test_compiler_failure_falls_back);
+    RUN_TEST(test_rejects_invalid_params);
+
+    char cmd[128];
+    snprintf(cmd, sizeof(cmd), "rm -rf '%s'", cache_dir);
+    if (system(cmd) != 0)
+        printf("warning: could not remove %s\n", cache_dir);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/*
+ * Tests for the FFT and the Lenia continuous engine
+ * Compile: make test_lenia
+ * Run: ./test_lenia
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "fft.h"
+#include "lenia.h"
+#include "parallel.h"
+
+static void naive_dft(const double complex *in, double complex *out, int n) {
+    for (int k = 0; k < n; k++) {
+        out[k] = 0;
+        for (int j = 0; j < n; j++)
+            out[k] += in[j] * cexp(-2.0 * I * M_PI * ((long long)j * k % n) / n);
+    }
+}
+
+static void check_fft(int n) {
+    const FftPlan *plan = fft_plan_get(n);
+    assert(plan != NULL);
+    assert(fft_plan_get(n) == plan);
+
+    double complex *x = malloc(n * sizeof(double complex)), *want = malloc(n * sizeof(double complex));
+    double complex *scratch = malloc((fft_scratch_size(plan) + 1) * sizeof(double complex));
+    double complex *orig = malloc(n * sizeof(double complex));
+    for (int i = 0; i < n; i++)
+        orig[i] = x[i] = CMPLX(rand() / (double)RAND_MAX - 0.5, rand() / (double)RAND_MAX - 0.5);
+    naive_dft(x, want, n);
+
+    fft_execute(plan, x, 0, scratch);
+    for (int k = 0; k < n; k++)
+        assert(cabs(x[k] - want[k]) < 1e-9 * n);
+    fft_execute(plan, x, 1, scratch);
+    for (int i = 0; i < n; i++)
+        assert(cabs(x[i] / n - orig[i]) < 1e-9);
+
+    free(x); free(want); free(scratch); free(orig);
+}
+
+static float *random_grid(int cols, int rows, unsigned seed) {
+    float *g = malloc((size_t)cols * rows * sizeof(float));
+    srand(seed);
+    for (int i = 0; i < cols * rows; i++)
+        g[i] = rand() / (float)RAND_MAX;
+    return g;
+}
+
+static void check_convolution(int cols, int rows, int radius, int n_rings) {
+    LeniaParams params = LENIA_ORBIUM;
+    params.radius = radius;
+    params.n_rings = n_rings;
+    for (int i = 0; i < n_rings; i++)
+        params.rings[i] = 1.0f - 0.25f * i;
+
+    Lenia lenia;
+    assert(lenia_init(&lenia, cols, rows, &params) == 0);
+    float *grid = random_grid(cols, rows, cols * 31 + rows);
+    lenia_convolve(&lenia, grid);
+
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            double want = 0.0;
+            for (int dy = -radius; dy <= radius; dy++) {
+                for (int dx = -radius; dx <= radius; dx++) {
+                    int sx = ((x - dx) % cols + cols) % cols, sy = ((y - dy) % rows + rows) % rows;
+                    want += lenia_kernel_weight(&params, dx, dy) * grid[sy * cols + sx];
+                }
+            }
+            assert(fabs(lenia.potential[y * cols + x] - want) < 1e-4);
+        }
+    }
+    free(grid);
+    lenia_free(&lenia);
+}
+
+TEST(test_fft_power_of_two) {
+    for (int n = 1; n <= 256; n *= 2)
+        check_fft(n);
+}
+
+TEST(test_fft_bluestein) {
+    int sizes[] = {3, 5, 6, 7, 12, 15, 31, 100, 120};
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+        check_fft(sizes[i]);
+}
+
+TEST(test_kernel_is_normalized) {
+    double total = 0.0;
+    for (int dy = -13; dy <= 13; dy++) {
+        for (int dx = -13; dx <= 13; dx++)
+            total += lenia_kernel_weight(&LENIA_ORBIUM, dx, dy);
+    }
+    assert(fabs(total - 1.0) < 1e-5);
+    assert(lenia_kernel_weight(&LENIA_ORBIUM, 0, 0) == 0.0f);
+    assert(lenia_kernel_weight(&LENIA_ORBIUM, 14, 0) == 0.0f);
+}
+
+TEST(test_convolution_matches_direct) {
+    check_convolution(32, 32, 5, 1);
+    check_convolution(24, 19, 4, 2);
+    check_convolution(17, 8, 3, 3);
+}
+
+TEST(test_kernel_wraps_on_small_torus) {
+    /* Radius larger than the grid: the kernel folds like pos_to_index */
+    check_convolution(6, 5, 4, 1);
+}
+
+TEST(test_empty_grid_stays_empty) {
+    Lenia lenia;
+    assert(lenia_init(&lenia, 40, 30, &LENIA_ORBIUM) == 0);
+    float *grid = calloc(40 * 30, sizeof(float));
+    lenia_step(&lenia, grid, grid);
+    for (int i = 0; i < 40 * 30; i++)
+        assert(grid[i] == 0.0f);
+    free(grid);
+    lenia_free(&lenia);
+}
+
+TEST(test_step_matches_growth_formula) {
+    Lenia lenia;
+    assert(lenia_init(&lenia, 64, 48, &LENIA_ORBIUM) == 0);
+    float *grid = random_grid(64, 48, 7), *next = malloc(64 * 48 * sizeof(float));
+    lenia_step(&lenia, grid, next);
+    for (int i = 0; i < 64 * 48; i++) {
+        float d = lenia.potential[i] - LENIA_ORBIUM.mu;
+        float v = grid[i] + LENIA_ORBIUM.dt * (2.0f * expf(-d * d / (2.0f * LENIA_ORBIUM.sigma * LENIA_ORBIUM.sigma)) - 1.0f);
+        v = v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v;
+        assert(fabsf(next[i] - v) < 1e-6f);
+    }
+    free(grid); free(next);
+    lenia_free(&lenia);
+}
+
+TEST(test_thread_count_does_not_change_result) {
+    Lenia lenia;
+    assert(lenia_init(&lenia, 50, 36, &LENIA_ORBIUM) == 0);
+    float *a = random_grid(50, 36, 3), *b = random_grid(50, 36, 3);
+    parallel_set_thread_count(1);
+    for (int i = 0; i < 5; i++)
+        lenia_step(&lenia, a, a);
+    parallel_set_thread_count(4);
+    for (int i = 0; i < 5; i++)
+        lenia_step(&lenia, b, b);
+    parallel_set_thread_count(0);
+    assert(memcmp(a, b, 50 * 36 * sizeof(float)) == 0);
+    free(a); free(b);
+    lenia_free(&lenia);
+}
+
+TEST(test_rejects_invalid_params) {
+    Lenia lenia;
+    LeniaParams params = LENIA_ORBIUM;
+    params.n_rings = 0;
+    assert(lenia_init(&lenia, 16, 16, &params) == -1);
+    params = LENIA_ORBIUM;
+    params.sigma = 0.0f;
+    assert(lenia_init(&lenia, 16, 16, &params) == -1);
+    assert(lenia_init(&lenia, 0, 16, &LENIA_ORBIUM) == -1);
+}
+
+int main(void) {
+    printf("Running Lenia tests (C)...\n\n");
+
+    printf("FFT tests:\n");
+    RUN_TEST(test_fft_power_of_two);
+    RUN_TEST(test_fft_bluestein);
+
+    printf("\nEngine tests:\n");
+    RUN_TEST(test_kernel_is_normalized);
+    RUN_TEST(test_convolution_matches_direct);
+    RUN_TEST(test_kernel_wraps_on_small_torus);
+    RUN_TEST(test_empty_grid_stays_empty);
+    RUN_TEST(test_step_matches_growth_formula);
+    RUN_TEST(test_thread_count_does_not_change_result);
+    RUN_TEST(test_rejects_invalid_params);
+
+    parallel_shutdown();
+    fft_plans_clear();
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
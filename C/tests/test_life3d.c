@@ -0,0 +1,152 @@
+/*
+ * Tests for the bit-packed 3D Life engine
+ * Compile: make test_life3d
+ * Run: ./test_life3d
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "life3d.h"
+#include "parallel.h"
+
+static void reference_step(const Life3dRule *rule, const CellState *curr, CellState *next,
+                           int cols, int rows, int depth) {
+    for (int z = 0; z < depth; z++) {
+        for (int y = 0; y < rows; y++) {
+            for (int x = 0; x < cols; x++) {
+                int n = 0;
+                for (int dz = -1; dz <= 1; dz++) {
+                    for (int dy = -1; dy <= 1; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            if (dx || dy || dz)
+                                n += curr[life3d_index(x + dx, y + dy, z + dz, cols, rows, depth)] == ALIVE;
+                        }
+                    }
+                }
+                int i = life3d_index(x, y, z, cols, rows, depth);
+                uint32_t mask = curr[i] == ALIVE ? rule->survive : rule->birth;
+                next[i] = (mask >> n) & 1 ? ALIVE : DEAD;
+            }
+        }
+    }
+}
+
+static void check_rule(const char *rulestring, int cols, int rows, int depth, int generations) {
+    Life3dRule rule;
+    Life3dGrid a, b;
+    assert(life3d_rule_parse(&rule, rulestring) == 0);
+    assert(life3d_grid_init(&a, cols, rows, depth) == 0);
+    assert(life3d_grid_init(&b, cols, rows, depth) == 0);
+
+    size_t n = (size_t)cols * rows * depth;
+    CellState *ra = malloc(n * sizeof(CellState)), *rb = malloc(n * sizeof(CellState));
+    CellState *out = malloc(n * sizeof(CellState));
+    srand(cols + 7 * rows + 31 * depth);
+    for (size_t i = 0; i < n; i++)
+        ra[i] = rand() % 3 == 0 ? ALIVE : DEAD;
+    life3d_grid_load(&a, ra);
+
+    for (int gen = 0; gen < generations; gen++) {
+        life3d_step(&a, &b, &rule);
+        reference_step(&rule, ra, rb, cols, rows, depth);
+        life3d_grid_store(&b, out);
+        assert(memcmp(out, rb, n * sizeof(CellState)) == 0);
+        Life3dGrid t = a; a = b; b = t;
+        CellState *tc = ra; ra = rb; rb = tc;
+    }
+
+    free(ra); free(rb); free(out);
+    life3d_grid_free(&a);
+    life3d_grid_free(&b);
+}
+
+TEST(test_parse_bays_notation) {
+    Life3dRule rule;
+    assert(life3d_rule_parse(&rule, "4555") == 0);
+    assert(rule.survive == LIFE3D_RULE_4555.survive && rule.birth == LIFE3D_RULE_4555.birth);
+    assert(life3d_rule_parse(&rule, "5766") == 0);
+    assert(rule.survive == ((1u << 5) | (1u << 6) | (1u << 7)) && rule.birth == 1u << 6);
+    assert(life3d_rule_parse(&rule, "4,5,12,14") == 0);
+    assert(rule.birth == ((1u << 12) | (1u << 13) | (1u << 14)));
+}
+
+TEST(test_parse_birth_survive) {
+    Life3dRule rule;
+    assert(life3d_rule_parse(&rule, "B5/S4-5") == 0);
+    assert(rule.survive == LIFE3D_RULE_4555.survive && rule.birth == LIFE3D_RULE_4555.birth);
+    assert(life3d_rule_parse(&rule, "B5,26/S") == 0);
+    assert(rule.birth == ((1u << 5) | (1u << 26)) && rule.survive == 0);
+}
+
+TEST(test_parse_rejects_invalid) {
+    Life3dRule rule;
+    assert(life3d_rule_parse(&rule, "455") == -1);
+    assert(life3d_rule_parse(&rule, "5455") == -1);
+    assert(life3d_rule_parse(&rule, "4,5,5,27") == -1);
+    assert(life3d_rule_parse(&rule, "B5/S4-") == -1);
+    assert(life3d_rule_parse(&rule, "B5x/S4") == -1);
+}
+
+TEST(test_index_wraps_like_pos_to_index) {
+    assert(life3d_index(-1, 0, 0, 4, 3, 2) == 3);
+    assert(life3d_index(0, -1, 0, 4, 3, 2) == 8);
+    assert(life3d_index(0, 0, -1, 4, 3, 2) == 12);
+    assert(life3d_index(4, 3, 2, 4, 3, 2) == 0);
+}
+
+TEST(test_get_set_and_population) {
+    Life3dGrid g;
+    assert(life3d_grid_init(&g, 70, 3, 4) == 0);
+    life3d_set(&g, 69, 2, 3, ALIVE);
+    life3d_set(&g, -70, 0, 4, ALIVE);
+    assert(life3d_get(&g, -1, -1, -1) == ALIVE);
+    assert(life3d_get(&g, 0, 0, 0) == ALIVE);
+    assert(life3d_population(&g) == 2);
+    life3d_set(&g, 69, 2, 3, DEAD);
+    assert(life3d_population(&g) == 1);
+    life3d_grid_free(&g);
+}
+
+TEST(test_matches_reference) {
+    check_rule("4555", 12, 10, 9, 6);
+    check_rule("5766", 70, 6, 5, 4);
+    check_rule("B6/S5-7", 128, 4, 4, 3);
+    check_rule("B4-9/S2-12", 9, 8, 7, 4);
+}
+
+TEST(test_tiny_torus_matches_reference) {
+    /* Dimensions below 3 count the same voxel more than once */
+    check_rule("B4,5/S1-26", 2, 1, 2, 3);
+    check_rule("4555", 1, 3, 1, 3);
+}
+
+TEST(test_thread_count_does_not_change_result) {
+    parallel_set_thread_count(1);
+    check_rule("4555", 40, 20, 16, 3);
+    parallel_set_thread_count(4);
+    check_rule("4555", 40, 20, 16, 3);
+    parallel_set_thread_count(0);
+}
+
+int main(void) {
+    printf("Running 3D Life tests (C)...\n\n");
+
+    printf("Parsing tests:\n");
+    RUN_TEST(test_parse_bays_notation);
+    RUN_TEST(test_parse_birth_survive);
+    RUN_TEST(test_parse_rejects_invalid);
+
+    printf("\nGrid tests:\n");
+    RUN_TEST(test_index_wraps_like_pos_to_index);
+    RUN_TEST(test_get_set_and_population);
+
+    printf("\nEngine tests:\n");
+    RUN_TEST(test_matches_reference);
+    RUN_TEST(test_tiny_torus_matches_reference);
+    RUN_TEST(test_thread_count_does_not_change_result);
+
+    parallel_shutdown();
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/*
+ * Tests for rulestring parsing and table-driven generation stepping
+ * Uses the full GRID_COLS x GRID_ROWS core grid
+ * Compile: make test_life_rule
+ * Run: ./test_life_rule
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "game_core.h"
+
+static CellState grid[GRID_SIZE], next[GRID_SIZE], expected[GRID_SIZE];
+
+TEST(test_parse_conway_forms) {
+    const char *forms[] = {"B3/S23", "b3/s23", "S23/B3", "B3S23", "23/3"};
+    for (size_t i = 0; i < sizeof(forms) / sizeof(forms[0]); i++) {
+        LifeRule rule;
+        assert(life_rule_parse(&rule, forms[i]) == 0);
+        assert(memcmp(&rule, &LIFE_RULE_CONWAY, sizeof(rule)) == 0);
+    }
+}
+
+TEST(test_parse_table_contents) {
+    LifeRule rule;
+    assert(life_rule_parse(&rule, "B3678/S34678") == 0);
+    for (int n = 0; n <= 8; n++) {
+        int born = n == 3 || n == 6 || n == 7 || n == 8;
+        int stays = n == 3 || n == 4 || n == 6 || n == 7 || n == 8;
+        assert(rule.table[LIFE_RULE_INDEX(DEAD, n)] == born);
+        assert(rule.table[LIFE_RULE_INDEX(ALIVE, n)] == stays);
+    }
+}
+
+TEST(test_parse_empty_sets) {
+    LifeRule rule;
+    assert(life_rule_parse(&rule, "B/S") == 0);
+    assert(rule.birth == 0 && rule.survive == 0);
+    assert(life_rule_parse(&rule, "B2/S") == 0);
+    assert(rule.birth == (1 << 2) && rule.survive == 0);
+}
+
+TEST(test_parse_rejects_invalid) {
+    LifeRule rule;
+    assert(life_rule_parse(&rule, "") != 0);
+    assert(life_rule_parse(&rule, "B3") != 0);
+    assert(life_rule_parse(&rule, "B9/S23") != 0);
+    assert(life_rule_parse(&rule, "B3/S23/B4") != 0);
+    assert(life_rule_parse(&rule, "B3/S23/") != 0);
+    assert(life_rule_parse(&rule, "S23/B3/") != 0);
+    assert(life_rule_parse(&rule, "X3/S23") != 0);
+    assert(life_rule_parse(&rule, "23/3x") != 0);
+}
+
+TEST(test_format_round_trip) {
+    const char *rules[] = {"B3/S23", "B36/S23", "B3678/S34678", "B2/S", "B/S012345678"};
+    for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+        LifeRule rule;
+        char buf[32];
+        assert(life_rule_parse(&rule, rules[i]) == 0);
+        life_rule_format(&rule, buf, sizeof(buf));
+        assert(strcmp(buf, rules[i]) == 0);
+    }
+}
+
+TEST(test_conway_matches_neighbor_reference) {
+    srand(42);
+    for (int i = 0; i < GRID_SIZE; i++)
+        grid[i] = rand() % 3 == 0 ? ALIVE : DEAD;
+
+    for (int y = 0; y < GRID_ROWS; y++) {
+        for (int x = 0; x < GRID_COLS; x++) {
+            int n = get_alive_neighbors(grid, x, y);
+            int alive = n == 3 || (get_cell(grid, x, y) == ALIVE && n == 2);
+            set_cell(expected, x, y, alive ? ALIVE : DEAD);
+        }
+    }
+    compute_new_generation(grid, next);
+    assert(memcmp(next, expected, sizeof(next)) == 0);
+}
+
+TEST(test_highlife_birth_on_six) {
+    LifeRule highlife;
+    assert(life_rule_parse(&highlife, "B36/S23") == 0);
+    fill_grid(grid, DEAD);
+
+    /* Dead cell at (0,0) with six neighbors, across the wrap-around edge */
+    set_cell(grid, -1, -1, ALIVE);
+    set_cell(grid, 0, -1, ALIVE);
+    set_cell(grid, 1, -1, ALIVE);
+    set_cell(grid, -1, 1, ALIVE);
+    set_cell(grid, 0, 1, ALIVE);
+    set_cell(grid, 1, 1, ALIVE);
+
+    compute_new_generation_rule(grid, next, &highlife);
+    assert(get_cell(next, 0, 0) == ALIVE);
+    compute_new_generation(grid, next);
+    assert(get_cell(next, 0, 0) == DEAD);
+}
+
+int main(void) {
+    printf("Running rulestring tests (C)...\n\n");
+
+    printf("Parsing tests:\n");
+    RUN_TEST(test_parse_conway_forms);
+    RUN_TEST(test_parse_table_contents);
+    RUN_TEST(test_parse_empty_sets);
+    RUN_TEST(test_parse_rejects_invalid);
+    RUN_TEST(test_format_round_trip);
+
+    printf("\nTable-driven generation tests:\n");
+    RUN_TEST(test_conway_matches_neighbor_reference);
+    RUN_TEST(test_highlife_birth_on_six);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
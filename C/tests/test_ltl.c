@@ -0,0 +1,151 @@
+/*
+ * Tests for the Larger than Life engine and the worker pool
+ * Compile: make test_ltl
+ * Run: ./test_ltl
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "ltl.h"
+#include "parallel.h"
+
+static void reference_step(const LtlRule *rule, const CellState *curr, CellState *next, int cols, int rows) {
+    int r = rule->range;
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int n = 0;
+            for (int dy = -r; dy <= r; dy++) {
+                for (int dx = -r; dx <= r; dx++) {
+                    if (rule->neighborhood == LTL_VON_NEUMANN && abs(dx) + abs(dy) > r)
+                        continue;
+                    if (!rule->include_center && !dx && !dy)
+                        continue;
+                    n += curr[((y + dy) % rows + rows) % rows * cols + ((x + dx) % cols + cols) % cols] == ALIVE;
+                }
+            }
+            const uint8_t *table = curr[y * cols + x] == ALIVE ? rule->survive : rule->birth;
+            next[y * cols + x] = table[n] ? ALIVE : DEAD;
+        }
+    }
+}
+
+static void check_rule(const char *rulestring, int cols, int rows, int generations) {
+    LtlRule rule;
+    LtlEngine engine;
+    assert(ltl_rule_parse(&rule, rulestring) == 0);
+    assert(ltl_engine_init(&engine, cols, rows, &rule) == 0);
+
+    size_t n = (size_t)cols * rows;
+    CellState *a = malloc(n * sizeof(CellState)), *b = malloc(n * sizeof(CellState));
+    CellState *ra = malloc(n * sizeof(CellState)), *rb = malloc(n * sizeof(CellState));
+    srand(cols + 100 * rows);
+    for (size_t i = 0; i < n; i++)
+        a[i] = ra[i] = rand() % 2 ? ALIVE : DEAD;
+
+    for (int gen = 0; gen < generations; gen++) {
+        ltl_engine_step(&engine, a, b);
+        reference_step(&rule, ra, rb, cols, rows);
+        assert(memcmp(b, rb, n * sizeof(CellState)) == 0);
+        CellState *t = a; a = b; b = t;
+        t = ra; ra = rb; rb = t;
+    }
+
+    free(a); free(b); free(ra); free(rb);
+    ltl_engine_free(&engine);
+    ltl_rule_free(&rule);
+}
+
+TEST(test_parse_bosco) {
+    LtlRule rule;
+    assert(ltl_rule_parse(&rule, "R5,C0,M1,S34..58,B34..45,NM") == 0);
+    assert(rule.range == 5 && rule.include_center && rule.neighborhood == LTL_MOORE);
+    assert(rule.max_count == 121);
+    assert(!rule.survive[33] && rule.survive[34] && rule.survive[58] && !rule.survive[59]);
+    assert(!rule.birth[33] && rule.birth[34] && rule.birth[45] && !rule.birth[46]);
+    ltl_rule_free(&rule);
+}
+
+TEST(test_parse_lists_and_von_neumann) {
+    LtlRule rule;
+    assert(ltl_rule_parse(&rule, "R2,C2,M0,S2,4..5,B3-4,7,NN") == 0);
+    assert(rule.neighborhood == LTL_VON_NEUMANN && !rule.include_center);
+    assert(rule.max_count == 13);
+    assert(rule.survive[2] && !rule.survive[3] && rule.survive[4] && rule.survive[5]);
+    assert(rule.birth[3] && rule.birth[4] && !rule.birth[5] && rule.birth[7]);
+    ltl_rule_free(&rule);
+}
+
+TEST(test_parse_rejects_invalid) {
+    LtlRule rule;
+    assert(ltl_rule_parse(&rule, "C0,M1,S2..3,B3,NM") != 0);      /* no range */
+    assert(ltl_rule_parse(&rule, "R0,C0,M1,S2..3,B3,NM") != 0);
+    assert(ltl_rule_parse(&rule, "R2,C3,M1,S2..3,B3,NM") != 0);    /* multi-state */
+    assert(ltl_rule_parse(&rule, "R2,C0,M1,S2..3,B3,NX") != 0);
+    assert(ltl_rule_parse(&rule, "R2,C0,M1,S5..3,B3,NM") != 0);
+    assert(ltl_rule_parse(&rule, "R2,C0,Q1,S2..3,B3,NM") != 0);
+}
+
+TEST(test_range_one_is_conway) {
+    check_rule("R1,C0,M0,S2..3,B3,NM", 16, 12, 10);
+}
+
+TEST(test_moore_matches_reference) {
+    check_rule("R5,C0,M1,S34..58,B34..45,NM", 40, 33, 6);
+    check_rule("R3,C0,M0,S8..16,B10..14,NM", 29, 31, 6);
+    check_rule("R4,C0,M1,S10..30,B15..20,NM", 7, 5, 4);  /* range wider than the grid */
+}
+
+TEST(test_von_neumann_matches_reference) {
+    check_rule("R1,C0,M0,S1..2,B2,NN", 17, 13, 8);
+    check_rule("R4,C0,M1,S10..20,B12..16,NN", 37, 29, 6);
+    check_rule("R10,C0,M1,S60..120,B70..110,NN", 45, 40, 3);
+    check_rule("R6,C0,M0,S20..50,B25..40,NN", 9, 6, 4);
+}
+
+TEST(test_thread_count_does_not_change_result) {
+    parallel_set_thread_count(1);
+    check_rule("R3,C0,M1,S10..25,B12..20,NN", 50, 50, 4);
+    parallel_set_thread_count(4);
+    check_rule("R3,C0,M1,S10..25,B12..20,NN", 50, 50, 4);
+    check_rule("R3,C0,M1,S10..25,B12..20,NM", 50, 50, 4);
+    parallel_set_thread_count(0);
+}
+
+static void mark_range(int begin, int end, void *ctx) {
+    int *hits = ctx;
+    for (int i = begin; i < end; i++)
+        hits[i]++;
+}
+
+TEST(test_parallel_for_covers_range_once) {
+    static int hits[10007];
+    parallel_set_thread_count(3);
+    for (int round = 0; round < 50; round++) {
+        memset(hits, 0, sizeof(hits));
+        parallel_for(5, 10007, mark_range, hits);
+        for (int i = 0; i < 10007; i++)
+            assert(hits[i] == (i >= 5));
+    }
+    parallel_shutdown();
+    parallel_set_thread_count(0);
+}
+
+int main(void) {
+    printf("Running Larger than Life tests (C)...\n\n");
+
+    printf("Parsing tests:\n");
+    RUN_TEST(test_parse_bosco);
+    RUN_TEST(test_parse_lists_and_von_neumann);
+    RUN_TEST(test_parse_rejects_invalid);
+
+    printf("\nEngine tests:\n");
+    RUN_TEST(test_range_one_is_conway);
+    RUN_TEST(test_moore_matches_reference);
+    RUN_TEST(test_von_neumann_matches_reference);
+    RUN_TEST(test_thread_count_does_not_change_result);
+    RUN_TEST(test_parallel_for_covers_range_once);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+/*
+ * Tests for the batched neighbor-count API
+ * Compile: make test_neighbor_count
+ * Run: ./test_neighbor_count
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "neighbor_count.h"
+
+static int reference_count(const CellState *grid, int cols, int rows, int x, int y) {
+    int n = 0;
+    for (int dy = -1; dy <= 1; dy++)
+        for (int dx = -1; dx <= 1; dx++)
+            if (dx || dy)
+                n += grid[wrap_index(x + dx, y + dy, cols, rows)] == ALIVE;
+    return n;
+}
+
+static void check_rects(int cols, int rows, int trials) {
+    CellState *grid = malloc((size_t)cols * rows * sizeof(CellState));
+    uint8_t *counts = malloc((size_t)(cols + 3) * rows);
+    for (int i = 0; i < cols * rows; i++)
+        grid[i] = rand() % 2 ? ALIVE : DEAD;
+
+    for (int t = 0; t < trials; t++) {
+        int x = rand() % (3 * cols) - cols, y = rand() % (3 * rows) - rows;
+        int w = rand() % (cols + 1), h = rand() % (rows + 1), stride = w + 3;
+        assert(neighbor_count_rect(grid, cols, rows, x, y, w, h, counts, stride) == 0);
+        for (int r = 0; r < h; r++)
+            for (int c = 0; c < w; c++)
+                assert(counts[r * stride + c] == reference_count(grid, cols, rows, x + c, y + r));
+    }
+    free(grid);
+    free(counts);
+}
+
+TEST(test_rects_match_reference) {
+    check_rects(17, 11, 200);
+    check_rects(1, 1, 5);
+    check_rects(2, 3, 20);
+    check_rects(700, 5, 20);  /* spans several stack chunks */
+}
+
+TEST(test_row_matches_get_alive_neighbors) {
+    static CellState grid[GRID_SIZE];
+    uint8_t counts[GRID_COLS];
+    fill_grid(grid, DEAD);
+    srand(9);
+    randomize_grid(grid, 3);
+    for (int y = 0; y < GRID_ROWS; y++) {
+        assert(neighbor_count_row(grid, GRID_COLS, GRID_ROWS, y, counts) == 0);
+        for (int x = 0; x < GRID_COLS; x++)
+            assert(counts[x] == get_alive_neighbors(grid, x, y));
+    }
+}
+
+TEST(test_rejects_oversized_rect) {
+    CellState grid[4 * 4] = {DEAD};
+    uint8_t counts[5 * 5];
+    assert(neighbor_count_rect(grid, 4, 4, 0, 0, 5, 1, counts, 5) == -1);
+    assert(neighbor_count_rect(grid, 4, 4, 0, 0, 1, 5, counts, 5) == -1);
+    assert(neighbor_count_rect(grid, 4, 4, 0, 0, 0, 0, counts, 5) == 0);
+}
+
+TEST(test_full_neighborhood) {
+    CellState grid[5 * 5];
+    uint8_t counts[5 * 5];
+    for (int i = 0; i < 25; i++)
+        grid[i] = ALIVE;
+    assert(neighbor_count_rect(grid, 5, 5, 0, 0, 5, 5, counts, 5) == 0);
+    for (int i = 0; i < 25; i++)
+        assert(counts[i] == 8);
+}
+
+int main(void) {
+    printf("Running neighbor count tests (C)...\n\n");
+    srand(77);
+
+    printf("Batch tests:\n");
+    RUN_TEST(test_rects_match_reference);
+    RUN_TEST(test_row_matches_get_alive_neighbors);
+    RUN_TEST(test_rejects_oversized_rect);
+    RUN_TEST(test_full_neighborhood);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
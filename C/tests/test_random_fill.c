@@ -0,0 +1,114 @@
+/*
+ * Tests for the seeded parallel random initializer
+ * Compile: make test_random_fill
+ * Run: ./test_random_fill
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "random_fill.h"
+#include "parallel.h"
+
+static long count_alive(const CellState *cells, size_t n) {
+    long alive = 0;
+    for (size_t i = 0; i < n; i++)
+        alive += cells[i] == ALIVE;
+    return alive;
+}
+
+TEST(test_philox_known_answers) {
+    /* Known-answer vectors from the Random123 distribution */
+    uint32_t out[4];
+    uint32_t zero_ctr[4] = {0, 0, 0, 0}, zero_key[2] = {0, 0};
+    philox4x32(zero_ctr, zero_key, out);
+    assert(out[0] == 0x6627e8d5u && out[1] == 0xe169c58du && out[2] == 0xbc57ac4cu && out[3] == 0x9b00dbd8u);
+
+    uint32_t ones_ctr[4] = {~0u, ~0u, ~0u, ~0u}, ones_key[2] = {~0u, ~0u};
+    philox4x32(ones_ctr, ones_key, out);
+    assert(out[0] == 0x408f276du && out[1] == 0x41c83b0eu && out[2] == 0xa20bc7c6u && out[3] == 0x6d5451fdu);
+
+    uint32_t pi_ctr[4] = {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+    uint32_t pi_key[2] = {0xa4093822u, 0x299f31d0u};
+    philox4x32(pi_ctr, pi_key, out);
+    assert(out[0] == 0xd16cfe09u && out[1] == 0x94fdccebu && out[2] == 0x5001e420u && out[3] == 0x24126ea1u);
+}
+
+TEST(test_density_is_respected) {
+    size_t n = 1 << 20;
+    CellState *cells = malloc(n * sizeof(CellState));
+    double densities[] = {0.01, 0.25, 0.3, 0.5, 0.9};
+    for (int i = 0; i < 5; i++) {
+        random_fill(cells, n, densities[i], 42);
+        double measured = (double)count_alive(cells, n) / n;
+        assert(measured > densities[i] - 0.005 && measured < densities[i] + 0.005);
+    }
+    random_fill(cells, n, 0.0, 42);
+    assert(count_alive(cells, n) == 0);
+    random_fill(cells, n, 1.0, 42);
+    assert(count_alive(cells, (size_t)n) == (long)n);
+    free(cells);
+}
+
+TEST(test_same_seed_same_cells) {
+    size_t n = 50001;
+    CellState *a = malloc(n * sizeof(CellState)), *b = malloc(n * sizeof(CellState));
+    random_fill(a, n, 0.37, 7);
+    random_fill(b, n, 0.37, 7);
+    assert(memcmp(a, b, n * sizeof(CellState)) == 0);
+    random_fill(b, n, 0.37, 8);
+    assert(memcmp(a, b, n * sizeof(CellState)) != 0);
+    random_fill(b, n, 0.37, 7ULL | (1ULL << 40));
+    assert(memcmp(a, b, n * sizeof(CellState)) != 0);
+    free(a); free(b);
+}
+
+TEST(test_prefix_is_stable) {
+    /* A shorter fill is a prefix of a longer one with the same seed */
+    CellState a[1000], b[4099];
+    random_fill(a, 1000, 0.5, 99);
+    random_fill(b, 4099, 0.5, 99);
+    assert(memcmp(a, b, sizeof(a)) == 0);
+}
+
+TEST(test_thread_count_does_not_change_result) {
+    size_t n = 300007;
+    CellState *one = malloc(n * sizeof(CellState)), *many = malloc(n * sizeof(CellState));
+    parallel_set_thread_count(1);
+    random_fill(one, n, 0.2, 12345);
+    for (int threads = 2; threads <= 5; threads++) {
+        parallel_set_thread_count(threads);
+        random_fill(many, n, 0.2, 12345);
+        assert(memcmp(one, many, n * sizeof(CellState)) == 0);
+    }
+    parallel_set_thread_count(0);
+    free(one); free(many);
+}
+
+TEST(test_randomize_grid_seeded_fills_core_grid) {
+    static CellState grid[GRID_SIZE], again[GRID_SIZE];
+    fill_grid(grid, ALIVE);
+    randomize_grid_seeded(grid, 0.25, 3);
+    long alive = count_alive(grid, GRID_SIZE);
+    assert(alive > GRID_SIZE / 5 && alive < GRID_SIZE * 3 / 10);
+    random_fill(again, GRID_SIZE, 0.25, 3);
+    assert(memcmp(grid, again, sizeof(grid)) == 0);
+}
+
+int main(void) {
+    printf("Running random fill tests (C)...\n\n");
+
+    printf("Generator tests:\n");
+    RUN_TEST(test_philox_known_answers);
+
+    printf("\nFill tests:\n");
+    RUN_TEST(test_density_is_respected);
+    RUN_TEST(test_same_seed_same_cells);
+    RUN_TEST(test_prefix_is_stable);
+    RUN_TEST(test_thread_count_does_not_change_result);
+    RUN_TEST(test_randomize_grid_seeded_fills_core_grid);
+
+    parallel_shutdown();
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
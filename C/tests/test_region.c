@@ -0,0 +1,141 @@
+/*
+ * Tests for the bulk region operations
+ * Compile: make test_region
+ * Run: ./test_region
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "region.h"
+
+static CellState apply(CellState d, CellState s, BlitOp op) {
+    switch (op) {
+    case BLIT_OR: return (CellState)(d | s);
+    case BLIT_AND: return (CellState)(d & s);
+    case BLIT_XOR: return (CellState)(d ^ s);
+    default: return s;
+    }
+}
+
+static void random_cells(CellState *cells, int n) {
+    for (int i = 0; i < n; i++)
+        cells[i] = rand() % 2 ? ALIVE : DEAD;
+}
+
+TEST(test_split_counts) {
+    RegionPiece p[4];
+    assert(region_split(10, 8, 2, 3, 4, 4, p) == 1);
+    assert(p[0].x == 2 && p[0].y == 3 && p[0].w == 4 && p[0].h == 4);
+    assert(region_split(10, 8, 8, 3, 4, 4, p) == 2);
+    assert(p[0].w == 2 && p[1].x == 0 && p[1].w == 2 && p[1].dx == 2);
+    assert(region_split(10, 8, 2, 6, 4, 4, p) == 2);
+    assert(region_split(10, 8, -1, -1, 4, 4, p) == 4);
+    assert(p[0].x == 9 && p[0].y == 7 && p[3].x == 0 && p[3].y == 0 && p[3].dx == 1 && p[3].dy == 1);
+    assert(region_split(10, 8, 0, 0, 0, 4, p) == 0);
+    assert(region_split(10, 8, 0, 0, 11, 4, p) == -1);
+    assert(region_split(10, 8, 5, 5, 10, 8, p) == 4);
+}
+
+TEST(test_fill_matches_set_cell) {
+    int cols = 13, rows = 9;
+    CellState grid[13 * 9], ref[13 * 9];
+    for (int trial = 0; trial < 200; trial++) {
+        int x = rand() % 40 - 20, y = rand() % 40 - 20, w = rand() % (cols + 1), h = rand() % (rows + 1);
+        CellState state = trial % 2 ? ALIVE : DEAD;
+        random_cells(grid, cols * rows);
+        memcpy(ref, grid, sizeof(grid));
+        for (int dy = 0; dy < h; dy++)
+            for (int dx = 0; dx < w; dx++)
+                ref[wrap_index(x + dx, y + dy, cols, rows)] = state;
+        assert(region_fill(grid, cols, rows, x, y, w, h, state) == 0);
+        assert(memcmp(grid, ref, sizeof(grid)) == 0);
+    }
+    assert(region_fill(grid, cols, rows, 0, 0, cols + 1, 1, ALIVE) == -1);
+}
+
+TEST(test_blit_ops_match_reference) {
+    int cols = 11, rows = 7;
+    CellState grid[11 * 7], ref[11 * 7], src[20 * 10];
+    for (int trial = 0; trial < 400; trial++) {
+        int x = rand() % 30 - 15, y = rand() % 30 - 15, w = rand() % (cols + 1), h = rand() % (rows + 1);
+        BlitOp op = (BlitOp)(trial % 4);
+        random_cells(grid, cols * rows);
+        random_cells(src, 20 * 10);
+        memcpy(ref, grid, sizeof(grid));
+        for (int dy = 0; dy < h; dy++) {
+            for (int dx = 0; dx < w; dx++) {
+                int i = wrap_index(x + dx, y + dy, cols, rows);
+                ref[i] = apply(ref[i], src[dy * 20 + dx], op);
+            }
+        }
+        assert(region_blit(grid, cols, rows, x, y, src, w, h, 20, op) == 0);
+        assert(memcmp(grid, ref, sizeof(grid)) == 0);
+    }
+}
+
+TEST(test_extract_roundtrip) {
+    int cols = 12, rows = 10;
+    CellState grid[12 * 10], out[12 * 10], back[12 * 10];
+    random_cells(grid, cols * rows);
+    assert(region_extract(grid, cols, rows, 9, 8, 6, 5, out, 6) == 0);
+    for (int dy = 0; dy < 5; dy++)
+        for (int dx = 0; dx < 6; dx++)
+            assert(out[dy * 6 + dx] == grid[wrap_index(9 + dx, 8 + dy, cols, rows)]);
+
+    /* Full-size extract at an offset, stamped back at the same offset */
+    assert(region_extract(grid, cols, rows, -5, 3, cols, rows, out, cols) == 0);
+    memset(back, 0, sizeof(back));
+    assert(region_blit(back, cols, rows, -5, 3, out, cols, rows, cols, BLIT_COPY) == 0);
+    assert(memcmp(back, grid, sizeof(grid)) == 0);
+}
+
+TEST(test_copy_between_grids) {
+    CellState a[9 * 8], b[14 * 6], ref[14 * 6];
+    for (int trial = 0; trial < 200; trial++) {
+        int w = rand() % 10, h = rand() % 7;
+        int sx = rand() % 20 - 10, sy = rand() % 20 - 10, dx = rand() % 20 - 10, dy = rand() % 20 - 10;
+        BlitOp op = (BlitOp)(trial % 4);
+        random_cells(a, 9 * 8);
+        random_cells(b, 14 * 6);
+        memcpy(ref, b, sizeof(b));
+        for (int r = 0; r < h; r++) {
+            for (int c = 0; c < w; c++) {
+                int i = wrap_index(dx + c, dy + r, 14, 6);
+                ref[i] = apply(ref[i], a[wrap_index(sx + c, sy + r, 9, 8)], op);
+            }
+        }
+        int expected = w > 9 || h > 6 ? -1 : 0;
+        assert(region_copy(b, 14, 6, dx, dy, a, 9, 8, sx, sy, w, h, op) == expected);
+        if (expected == 0)
+            assert(memcmp(b, ref, sizeof(b)) == 0);
+    }
+}
+
+TEST(test_fill_grid_uses_whole_grid) {
+    static CellState grid[GRID_SIZE];
+    fill_grid(grid, ALIVE);
+    for (int i = 0; i < GRID_SIZE; i++)
+        assert(grid[i] == ALIVE);
+    fill_grid(grid, DEAD);
+    for (int i = 0; i < GRID_SIZE; i++)
+        assert(grid[i] == DEAD);
+}
+
+int main(void) {
+    printf("Running region tests (C)...\n\n");
+    srand(2024);
+
+    printf("Splitting tests:\n");
+    RUN_TEST(test_split_counts);
+
+    printf("\nOperation tests:\n");
+    RUN_TEST(test_fill_matches_set_cell);
+    RUN_TEST(test_blit_ops_match_reference);
+    RUN_TEST(test_extract_roundtrip);
+    RUN_TEST(test_copy_between_grids);
+    RUN_TEST(test_fill_grid_uses_whole_grid);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
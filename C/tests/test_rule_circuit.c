@@ -0,0 +1,252 @@
+/*
+ * Tests for the bitsliced rule compiler and the bit-packed grid engine
+ * Compile: make test_rule_circuit
+ * Run: ./test_rule_circuit
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "game_core.h"
+#include "rule_circuit.h"
+#include "bitgrid.h"
+
+/* Lane bit i of each input word encodes (alive, count) = (i / 9, i % 9) */
+static void exhaustive_inputs(uint64_t in[RULE_CIRCUIT_INPUTS]) {
+    memset(in, 0, RULE_CIRCUIT_INPUTS * sizeof(uint64_t));
+    for (int i = 0; i < LIFE_RULE_TABLE_SIZE; i++) {
+        int alive = i / 9, count = i % 9;
+        for (int b = 0; b < 4; b++)
+            in[RC_B0 + b] |= (uint64_t)((count >> b) & 1) << i;
+        in[RC_ALIVE] |= (uint64_t)alive << i;
+    }
+}
+
+static void check_circuit(const LifeRule *rule) {
+    RuleCircuit circuit;
+    uint64_t in[RULE_CIRCUIT_INPUTS];
+    assert(rule_circuit_compile(&circuit, rule) == 0);
+    exhaustive_inputs(in);
+    uint64_t out = rule_circuit_eval(&circuit, in[RC_ALIVE], in[RC_B0], in[RC_B1], in[RC_B2], in[RC_B3]);
+    for (int i = 0; i < LIFE_RULE_TABLE_SIZE; i++)
+        assert(((out >> i) & 1) == rule->table[LIFE_RULE_INDEX(i / 9, i % 9)]);
+}
+
+TEST(test_named_rules_match_table) {
+    const char *rules[] = {"B3/S23", "B36/S23", "B3678/S34678", "B2/S", "B/S",
+                           "B012345678/S012345678", "B1357/S1357", "B35678/S5678"};
+    for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+        LifeRule rule;
+        assert(life_rule_parse(&rule, rules[i]) == 0);
+        check_circuit(&rule);
+    }
+}
+
+TEST(test_random_rules_match_table) {
+    srand(7);
+    for (int i = 0; i < 3000; i++) {
+        LifeRule rule;
+        life_rule_from_masks(&rule, rand() & 0x1ff, rand() & 0x1ff);
+        check_circuit(&rule);
+    }
+}
+
+TEST(test_conway_circuit_is_small) {
+    RuleCircuit circuit;
+    rule_circuit_compile(&circuit, &LIFE_RULE_CONWAY);
+    /* b1 & ~(b2 | b3) & (b0 | alive) */
+    assert(circuit.n_ops <= 5);
+}
+
+TEST(test_row_eval_matches_word_eval) {
+    enum { WORDS = 7 };
+    static uint64_t regs[RULE_CIRCUIT_MAX_REGS * WORDS];
+    LifeRule rule;
+    RuleCircuit circuit;
+    assert(life_rule_parse(&rule, "B3678/S34678") == 0);
+    rule_circuit_compile(&circuit, &rule);
+
+    srand(3);
+    for (int r = 0; r < RULE_CIRCUIT_INPUTS; r++)
+        for (int w = 0; w < WORDS; w++)
+            regs[r * WORDS + w] = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+    uint64_t in[RULE_CIRCUIT_INPUTS][WORDS];
+    memcpy(in, regs, sizeof(in));
+
+    const uint64_t *out = rule_circuit_eval_rows(&circuit, regs, WORDS);
+    for (int w = 0; w < WORDS; w++)
+        assert(out[w] == rule_circuit_eval(&circuit, in[RC_ALIVE][w], in[RC_B0][w], in[RC_B1][w],
+                                           in[RC_B2][w], in[RC_B3][w]));
+}
+
+TEST(test_emit_c_names_function) {
+    RuleCircuit circuit;
+    char text[4096] = {0};
+    rule_circuit_compile(&circuit, &LIFE_RULE_CONWAY);
+    FILE *f = tmpfile();
+    assert(f != NULL);
+    rule_circuit_emit_c(&circuit, f, "conway_next");
+    rewind(f);
+    size_t n = fread(text, 1, sizeof(text) - 1, f);
+    fclose(f);
+    assert(n > 0);
+    assert(strstr(text, "static inline uint64_t conway_next(") != NULL);
+    assert(strstr(text, "return ") != NULL);
+}
+
+/* Offsets inside the neighborhood; hex rows are offset by half a cell */
+static int is_neighbor(Neighborhood neighborhood, int dx, int dy, int y) {
+    if (!dx && !dy)
+        return 0;
+    switch (neighborhood) {
+    case NEIGHBORHOOD_HEX: return dy == 0 || dx == 0 || dx == ((y & 1) ? 1 : -1);
+    case NEIGHBORHOOD_VON_NEUMANN: return !dx || !dy;
+    default: return 1;
+    }
+}
+
+static void reference_step(const CellState *curr, CellState *next, int cols, int rows, const LifeRule *rule,
+                           Neighborhood neighborhood) {
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                    if (is_neighbor(neighborhood, dx, dy, y))
+                        n += curr[((y + dy + rows) % rows) * cols + (x + dx + cols) % cols] == ALIVE;
+            next[y * cols + x] = rule->table[LIFE_RULE_INDEX(curr[y * cols + x], n)] ? ALIVE : DEAD;
+        }
+    }
+}
+
+static void check_bitgrid(int cols, int rows, const char *rulestring, Neighborhood neighborhood) {
+    LifeRule rule;
+    RuleCircuit circuit;
+    BitGrid a, b;
+    assert(life_rule_parse(&rule, rulestring) == 0);
+    rule_circuit_compile(&circuit, &rule);
+    assert(bitgrid_init(&a, cols, rows) == 0);
+    assert(bitgrid_init(&b, cols, rows) == 0);
+    uint64_t *scratch = malloc(bitgrid_scratch_words(&a) * sizeof(uint64_t));
+    CellState *ref = malloc(cols * rows * sizeof(CellState));
+    CellState *tmp = malloc(cols * rows * sizeof(CellState));
+    CellState *out = malloc(cols * rows * sizeof(CellState));
+
+    srand(cols * 31 + rows);
+    for (int i = 0; i < cols * rows; i++)
+        ref[i] = rand() % 3 == 0 ? ALIVE : DEAD;
+    bitgrid_load(&a, ref);
+
+    for (int gen = 0; gen < 20; gen++) {
+        assert(bitgrid_step_neighborhood(&a, &b, &circuit, neighborhood, scratch) == 0);
+        BitGrid t = a;
+        a = b;
+        b = t;
+        reference_step(ref, tmp, cols, rows, &rule, neighborhood);
+        memcpy(ref, tmp, cols * rows * sizeof(CellState));
+        bitgrid_store(&a, out);
+        assert(memcmp(out, ref, cols * rows * sizeof(CellState)) == 0);
+    }
+
+    free(scratch);
+    free(ref);
+    free(tmp);
+    free(out);
+    bitgrid_free(&a);
+    bitgrid_free(&b);
+}
+
+TEST(test_bitgrid_matches_reference_odd_widths) {
+    int sizes[][2] = {{3, 3}, {5, 7}, {63, 9}, {64, 8}, {65, 6}, {130, 11}, {200, 4}};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        check_bitgrid(sizes[i][0], sizes[i][1], "B3/S23", NEIGHBORHOOD_MOORE);
+        check_bitgrid(sizes[i][0], sizes[i][1], "B36/S23", NEIGHBORHOOD_MOORE);
+        check_bitgrid(sizes[i][0], sizes[i][1], "B3678/S34678", NEIGHBORHOOD_MOORE);
+    }
+}
+
+TEST(test_bitgrid_hex_matches_reference) {
+    int sizes[][2] = {{3, 4}, {5, 8}, {63, 10}, {64, 8}, {65, 6}, {130, 12}};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        check_bitgrid(sizes[i][0], sizes[i][1], "B2/S34", NEIGHBORHOOD_HEX);
+        check_bitgrid(sizes[i][0], sizes[i][1], "B245/S3", NEIGHBORHOOD_HEX);
+        check_bitgrid(sizes[i][0], sizes[i][1], "B1/S0123456", NEIGHBORHOOD_HEX);
+    }
+}
+
+TEST(test_bitgrid_hex_rejects_odd_rows) {
+    /* Offset rows do not line up across the wrap of an odd-height torus */
+    LifeRule rule;
+    RuleCircuit circuit;
+    BitGrid a, b;
+    assert(life_rule_parse(&rule, "B2/S34") == 0);
+    rule_circuit_compile(&circuit, &rule);
+    assert(bitgrid_init(&a, 10, 5) == 0);
+    assert(bitgrid_init(&b, 10, 5) == 0);
+    uint64_t *scratch = malloc(bitgrid_scratch_words(&a) * sizeof(uint64_t));
+    bitgrid_set(&a, 3, 2, ALIVE);
+    bitgrid_set(&b, 7, 4, ALIVE);
+    assert(bitgrid_step_hex(&a, &b, &circuit, scratch) == -1);
+    assert(bitgrid_step_neighborhood(&a, &b, &circuit, NEIGHBORHOOD_HEX, scratch) == -1);
+    assert(bitgrid_get(&b, 7, 4) == ALIVE && bitgrid_get(&b, 3, 2) == DEAD);
+    assert(bitgrid_step_neighborhood(&a, &b, &circuit, NEIGHBORHOOD_MOORE, scratch) == 0);
+    free(scratch);
+    bitgrid_free(&a);
+    bitgrid_free(&b);
+}
+
+TEST(test_bitgrid_von_neumann_matches_reference) {
+    int sizes[][2] = {{3, 3}, {5, 7}, {63, 9}, {64, 8}, {65, 6}, {130, 11}};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        check_bitgrid(sizes[i][0], sizes[i][1], "B1/S1", NEIGHBORHOOD_VON_NEUMANN);
+        check_bitgrid(sizes[i][0], sizes[i][1], "B13/S024", NEIGHBORHOOD_VON_NEUMANN);
+        check_bitgrid(sizes[i][0], sizes[i][1], "B2/S", NEIGHBORHOOD_VON_NEUMANN);
+    }
+}
+
+TEST(test_bitgrid_matches_core_engine) {
+    static CellState grid[GRID_SIZE], next[GRID_SIZE], out[GRID_SIZE];
+    LifeRule rule;
+    RuleCircuit circuit;
+    BitGrid a, b;
+    assert(life_rule_parse(&rule, "B36/S23") == 0);
+    rule_circuit_compile(&circuit, &rule);
+    assert(bitgrid_init(&a, GRID_COLS, GRID_ROWS) == 0);
+    assert(bitgrid_init(&b, GRID_COLS, GRID_ROWS) == 0);
+    uint64_t *scratch = malloc(bitgrid_scratch_words(&a) * sizeof(uint64_t));
+
+    fill_grid(grid, DEAD);
+    srand(11);
+    randomize_grid(grid, 3);
+    bitgrid_load(&a, grid);
+    compute_new_generation_rule(grid, next, &rule);
+    bitgrid_step(&a, &b, &circuit, scratch);
+    bitgrid_store(&b, out);
+    assert(memcmp(out, next, sizeof(out)) == 0);
+    assert(bitgrid_get(&b, -1, -1) == get_cell(next, GRID_COLS - 1, GRID_ROWS - 1));
+
+    free(scratch);
+    bitgrid_free(&a);
+    bitgrid_free(&b);
+}
+
+int main(void) {
+    printf("Running rule compiler tests (C)...\n\n");
+
+    printf("Circuit synthesis tests:\n");
+    RUN_TEST(test_named_rules_match_table);
+    RUN_TEST(test_random_rules_match_table);
+    RUN_TEST(test_conway_circuit_is_small);
+    RUN_TEST(test_row_eval_matches_word_eval);
+    RUN_TEST(test_emit_c_names_function);
+
+    printf("\nBit-packed grid tests:\n");
+    RUN_TEST(test_bitgrid_matches_reference_odd_widths);
+    RUN_TEST(test_bitgrid_matches_core_engine);
+    RUN_TEST(test_bitgrid_hex_matches_reference);
+    RUN_TEST(test_bitgrid_hex_rejects_odd_rows);
+    RUN_TEST(test_bitgrid_von_neumann_matches_reference);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/*
+ * Tests for lock-free snapshot publication
+ * Compile: make test_snapshot
+ * Run: ./test_snapshot
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "snapshot.h"
+
+#define COLS 37
+#define ROWS 23
+#define N_READERS 3
+#define N_PUBLISHES 20000
+
+/* Generation g stores cell i as (g + i) % 2, so a torn grid is detectable. */
+static void fill_pattern(CellState *cells, uint64_t generation) {
+    for (int i = 0; i < COLS * ROWS; i++)
+        cells[i] = (CellState)((generation + i) % 2);
+}
+
+static int matches_pattern(const CellState *cells, uint64_t generation) {
+    for (int i = 0; i < COLS * ROWS; i++)
+        if (cells[i] != (CellState)((generation + i) % 2))
+            return 0;
+    return 1;
+}
+
+TEST(test_acquire_before_publish_fails) {
+    SnapshotRing *ring = snapshot_ring_create(COLS, ROWS, 1);
+    SnapshotView view;
+    assert(ring);
+    assert(snapshot_front_buffer(ring) == NULL);
+    assert(snapshot_acquire(ring, &view) == -1);
+    snapshot_ring_destroy(ring);
+    assert(snapshot_ring_create(0, ROWS, 1) == NULL);
+    assert(snapshot_ring_create(COLS, ROWS, 0) == NULL);
+}
+
+TEST(test_publish_and_acquire) {
+    SnapshotRing *ring = snapshot_ring_create(COLS, ROWS, 2);
+    SnapshotView view;
+    CellState *back = snapshot_back_buffer(ring);
+    fill_pattern(back, 7);
+    snapshot_publish(ring, 7);
+    assert(snapshot_front_buffer(ring) == back);
+    assert(snapshot_back_buffer(ring) != back);
+
+    assert(snapshot_acquire(ring, &view) == 0);
+    assert(view.generation == 7 && view.cells == back);
+    assert(matches_pattern(view.cells, 7));
+    snapshot_release(ring, &view);
+    assert(view.cells == NULL);
+    snapshot_ring_destroy(ring);
+}
+
+TEST(test_held_views_stay_immutable) {
+    SnapshotRing *ring = snapshot_ring_create(COLS, ROWS, 2);
+    SnapshotView a, b, extra;
+    fill_pattern(snapshot_back_buffer(ring), 1);
+    snapshot_publish(ring, 1);
+    assert(snapshot_acquire(ring, &a) == 0);
+    fill_pattern(snapshot_back_buffer(ring), 2);
+    snapshot_publish(ring, 2);
+    assert(snapshot_acquire(ring, &b) == 0);
+    assert(snapshot_acquire(ring, &extra) == -1);
+
+    /* Both readers hold slots; the writer keeps publishing without waiting. */
+    for (uint64_t g = 3; g < 50; g++) {
+        CellState *back = snapshot_back_buffer(ring);
+        assert(back != a.cells && back != b.cells);
+        fill_pattern(back, g);
+        snapshot_publish(ring, g);
+    }
+    assert(a.generation == 1 && matches_pattern(a.cells, 1));
+    assert(b.generation == 2 && matches_pattern(b.cells, 2));
+
+    snapshot_release(ring, &a);
+    assert(snapshot_acquire(ring, &a) == 0);
+    assert(a.generation == 49 && matches_pattern(a.cells, 49));
+    snapshot_release(ring, &a);
+    snapshot_release(ring, &b);
+    snapshot_ring_destroy(ring);
+}
+
+typedef struct {
+    SnapshotRing *ring;
+    atomic_int *stop;
+    int torn;
+    int went_back;
+    long views;
+} ReaderArgs;
+
+static void *reader_main(void *arg) {
+    ReaderArgs *r = arg;
+    uint64_t last = 0;
+    while (!atomic_load(r->stop)) {
+        SnapshotView view;
+        if (snapshot_acquire(r->ring, &view) != 0)
+            continue;
+        r->torn += !matches_pattern(view.cells, view.generation);
+        r->went_back += view.generation < last;
+        last = view.generation;
+        r->views++;
+        snapshot_release(r->ring, &view);
+    }
+    return NULL;
+}
+
+TEST(test_concurrent_readers_see_whole_generations) {
+    SnapshotRing *ring = snapshot_ring_create(COLS, ROWS, N_READERS);
+    atomic_int stop;
+    pthread_t threads[N_READERS];
+    ReaderArgs args[N_READERS];
+    atomic_init(&stop, 0);
+
+    fill_pattern(snapshot_back_buffer(ring), 0);
+    snapshot_publish(ring, 0);
+    for (int i = 0; i < N_READERS; i++) {
+        args[i] = (ReaderArgs){ring, &stop, 0, 0, 0};
+        pthread_create(&threads[i], NULL, reader_main, &args[i]);
+    }
+    for (uint64_t g = 1; g <= N_PUBLISHES; g++) {
+        /* Each generation is derived from the front buffer, as a step would. */
+        const CellState *front = snapshot_front_buffer(ring);
+        CellState *back = snapshot_back_buffer(ring);
+        for (int i = 0; i < COLS * ROWS; i++)
+            back[i] = (CellState)!front[i];
+        snapshot_publish(ring, g);
+    }
+    atomic_store(&stop, 1);
+    for (int i = 0; i < N_READERS; i++) {
+        pthread_join(threads[i], NULL);
+        assert(args[i].torn == 0 && args[i].went_back == 0);
+    }
+    snapshot_ring_destroy(ring);
+}
+
+int main(void) {
+    printf("Running snapshot tests (C)...\n\n");
+
+    printf("Publication tests:\n");
+    RUN_TEST(test_acquire_before_publish_fails);
+    RUN_TEST(test_publish_and_acquire);
+    RUN_TEST(test_held_views_stay_immutable);
+
+    printf("\nConcurrency tests:\n");
+    RUN_TEST(test_concurrent_readers_see_whole_generations);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
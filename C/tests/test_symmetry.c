@@ -0,0 +1,169 @@
+/*
+ * Tests for the symmetric soup engine
+ * Compile: make test_symmetry
+ * Run: ./test_symmetry
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "symmetry.h"
+#include "parallel.h"
+
+static void reference_step(const CellState *curr, CellState *next, int cols, int rows, const LifeRule *rule) {
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                    if (dx || dy)
+                        n += curr[wrap_index(x + dx, y + dy, cols, rows)] == ALIVE;
+            next[y * cols + x] = rule->table[LIFE_RULE_INDEX(curr[y * cols + x], n)] ? ALIVE : DEAD;
+        }
+    }
+}
+
+static int has_symmetry(const CellState *g, int cols, int rows, Symmetry symmetry) {
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            CellState c = g[y * cols + x];
+            if (symmetry == SYMMETRY_C2 && c != g[(rows - 1 - y) * cols + cols - 1 - x])
+                return 0;
+            if (symmetry != SYMMETRY_C2 && c != g[(rows - 1 - y) * cols + x])
+                return 0;
+            if (symmetry == SYMMETRY_D4 && c != g[y * cols + cols - 1 - x])
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static void check_symmetry(Symmetry symmetry, int cols, int rows, const char *rulestring, int generations) {
+    LifeRule rule;
+    SymmetricSoup soup;
+    assert(life_rule_parse(&rule, rulestring) == 0);
+    assert(symmetric_soup_init(&soup, cols, rows, symmetry, &rule) == 0);
+
+    size_t n = (size_t)cols * rows;
+    CellState *ref = malloc(n * sizeof(CellState)), *tmp = malloc(n * sizeof(CellState));
+    CellState *out = malloc(n * sizeof(CellState));
+    symmetric_soup_randomize(&soup, 0.5, (uint64_t)(cols * 7 + rows + symmetry));
+    symmetric_soup_store(&soup, ref);
+    assert(has_symmetry(ref, cols, rows, symmetry));
+
+    for (int gen = 0; gen < generations; gen++) {
+        symmetric_soup_step(&soup);
+        reference_step(ref, tmp, cols, rows, &rule);
+        memcpy(ref, tmp, n * sizeof(CellState));
+        symmetric_soup_store(&soup, out);
+        assert(memcmp(out, ref, n * sizeof(CellState)) == 0);
+    }
+
+    long population = 0;
+    for (size_t i = 0; i < n; i++)
+        population += ref[i] == ALIVE;
+    assert(symmetric_soup_population(&soup) == population);
+
+    free(ref); free(tmp); free(out);
+    symmetric_soup_free(&soup);
+}
+
+TEST(test_parse_names) {
+    Symmetry s;
+    assert(symmetry_parse(&s, "C2_4") == 0 && s == SYMMETRY_C2);
+    assert(symmetry_parse(&s, "D2_+2") == 0 && s == SYMMETRY_D2);
+    assert(symmetry_parse(&s, "D4") == 0 && s == SYMMETRY_D4);
+    assert(strcmp(symmetry_name(SYMMETRY_D4), "D4_+4") == 0);
+    assert(symmetry_parse(&s, "D8_4") == -1);
+}
+
+TEST(test_rejects_odd_sizes) {
+    SymmetricSoup soup;
+    assert(symmetric_soup_init(&soup, 15, 16, SYMMETRY_D4, &LIFE_RULE_CONWAY) == -1);
+    assert(symmetric_soup_init(&soup, 16, 15, SYMMETRY_C2, &LIFE_RULE_CONWAY) == -1);
+    assert(symmetric_soup_init(&soup, 15, 16, SYMMETRY_D2, &LIFE_RULE_CONWAY) == 0);
+    assert(soup.dom_cols == 15 && soup.dom_rows == 8);
+    symmetric_soup_free(&soup);
+}
+
+TEST(test_c2_matches_full_board) {
+    check_symmetry(SYMMETRY_C2, 16, 16, "B3/S23", 40);
+    check_symmetry(SYMMETRY_C2, 21, 10, "B36/S23", 40);
+    check_symmetry(SYMMETRY_C2, 2, 2, "B3/S23", 5);
+}
+
+TEST(test_d2_matches_full_board) {
+    check_symmetry(SYMMETRY_D2, 16, 16, "B3/S23", 40);
+    check_symmetry(SYMMETRY_D2, 13, 6, "B3678/S34678", 40);
+}
+
+TEST(test_d4_matches_full_board) {
+    check_symmetry(SYMMETRY_D4, 16, 16, "B3/S23", 40);
+    check_symmetry(SYMMETRY_D4, 24, 10, "B36/S23", 40);
+    check_symmetry(SYMMETRY_D4, GRID_COLS, GRID_ROWS, "B3/S23", 10);
+}
+
+TEST(test_domain_matches_core_engine) {
+    static CellState grid[GRID_SIZE], next[GRID_SIZE], out[GRID_SIZE];
+    SymmetricSoup soup;
+    assert(symmetric_soup_init(&soup, GRID_COLS, GRID_ROWS, SYMMETRY_C2, &LIFE_RULE_CONWAY) == 0);
+    symmetric_soup_randomize(&soup, 1.0 / 3, 5);
+    symmetric_soup_store(&soup, grid);
+
+    /* load takes the domain back out of a full board */
+    SymmetricSoup copy;
+    assert(symmetric_soup_init(&copy, GRID_COLS, GRID_ROWS, SYMMETRY_C2, &LIFE_RULE_CONWAY) == 0);
+    symmetric_soup_load(&copy, grid);
+
+    compute_new_generation(grid, next);
+    symmetric_soup_step(&copy);
+    symmetric_soup_store(&copy, out);
+    assert(memcmp(out, next, sizeof(out)) == 0);
+    assert(symmetric_soup_get(&copy, -1, -1) == get_cell(next, GRID_COLS - 1, GRID_ROWS - 1));
+
+    symmetric_soup_free(&soup);
+    symmetric_soup_free(&copy);
+}
+
+TEST(test_randomize_is_seeded) {
+    /* The same seed gives the same soup on any thread count */
+    SymmetricSoup a, b;
+    assert(symmetric_soup_init(&a, 40, 30, SYMMETRY_D2, &LIFE_RULE_CONWAY) == 0);
+    assert(symmetric_soup_init(&b, 40, 30, SYMMETRY_D2, &LIFE_RULE_CONWAY) == 0);
+    parallel_set_thread_count(1);
+    symmetric_soup_randomize(&a, 0.4, 77);
+    parallel_set_thread_count(4);
+    symmetric_soup_randomize(&b, 0.4, 77);
+    parallel_set_thread_count(0);
+    long population = symmetric_soup_population(&a);
+    assert(population > 0 && population == symmetric_soup_population(&b));
+    for (int y = 0; y < 30; y++)
+        for (int x = 0; x < 40; x++)
+            assert(symmetric_soup_get(&a, x, y) == symmetric_soup_get(&b, x, y));
+    symmetric_soup_randomize(&b, 0.4, 78);
+    int differ = 0;
+    for (int y = 0; y < 30; y++)
+        for (int x = 0; x < 40; x++)
+            differ += symmetric_soup_get(&a, x, y) != symmetric_soup_get(&b, x, y);
+    assert(differ > 0);
+    symmetric_soup_free(&a);
+    symmetric_soup_free(&b);
+}
+
+int main(void) {
+    printf("Running symmetric soup tests (C)...\n\n");
+
+    printf("Setup tests:\n");
+    RUN_TEST(test_parse_names);
+    RUN_TEST(test_rejects_odd_sizes);
+
+    printf("\nEngine tests:\n");
+    RUN_TEST(test_c2_matches_full_board);
+    RUN_TEST(test_d2_matches_full_board);
+    RUN_TEST(test_d4_matches_full_board);
+    RUN_TEST(test_domain_matches_core_engine);
+    RUN_TEST(test_randomize_is_seeded);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,385 @@
+/*
+ * Tests for the policy-based C++ Universe
+ * Compile: make test_universe
+ * Run: ./test_universe
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "test_helpers.h"
+#include "universe.hpp"
+
+/* Counts operator new calls so stepping can be checked for allocations. Every
+ * replaceable new/delete form is replaced, so each new pairs with a matching
+ * delete and all of them go through malloc/free. Releasing goes through a
+ * call the compiler cannot inline, so it does not mistake an inlined delete
+ * for free() on memory from a new-expression (-Wmismatched-new-delete). */
+static std::atomic<size_t> allocations{0};
+
+static void *counted_alloc(size_t size, size_t align) {
+    allocations++;
+    size = size ? size : 1;
+    void *p = align > alignof(std::max_align_t) ? std::aligned_alloc(align, (size + align - 1) / align * align)
+                                                : std::malloc(size);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+[[gnu::noinline]] static void release(void *p) noexcept { std::free(p); }
+
+void *operator new(size_t size) { return counted_alloc(size, 0); }
+void *operator new[](size_t size) { return counted_alloc(size, 0); }
+void *operator new(size_t size, std::align_val_t align) { return counted_alloc(size, (size_t)align); }
+void *operator new[](size_t size, std::align_val_t align) { return counted_alloc(size, (size_t)align); }
+
+void operator delete(void *p) noexcept { release(p); }
+void operator delete[](void *p) noexcept { release(p); }
+void operator delete(void *p, size_t) noexcept { release(p); }
+void operator delete[](void *p, size_t) noexcept { release(p); }
+void operator delete(void *p, std::align_val_t) noexcept { release(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { release(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { release(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { release(p); }
+
+static std::vector<CellState> reference_step(const std::vector<CellState> &grid, int cols, int rows, bool torus,
+                                             const LifeRule &rule) {
+    std::vector<CellState> next(grid.size());
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int nx = x + dx, ny = y + dy;
+                    if ((!dx && !dy) || (!torus && (nx < 0 || nx >= cols || ny < 0 || ny >= rows)))
+                        continue;
+                    n += grid[wrap_index(nx, ny, cols, rows)];
+                }
+            }
+            next[y * cols + x] = (CellState)rule.table[LIFE_RULE_INDEX(grid[y * cols + x], n)];
+        }
+    }
+    return next;
+}
+
+template <class U>
+static std::vector<CellState> random_fill(U &u, unsigned seed) {
+    std::vector<CellState> grid((size_t)u.cols() * u.rows());
+    srand(seed);
+    for (int y = 0; y < u.rows(); y++) {
+        for (int x = 0; x < u.cols(); x++) {
+            grid[y * u.cols() + x] = rand() % 3 ? DEAD : ALIVE;
+            u.set(x, y, grid[y * u.cols() + x]);
+        }
+    }
+    return grid;
+}
+
+template <class U>
+static void check_against_reference(int cols, int rows, bool torus, int generations) {
+    U u(cols, rows);
+    std::vector<CellState> grid = random_fill(u, cols * 31 + rows);
+    LifeRule rule = u.rule().c_rule();
+    for (int g = 0; g < generations; g++) {
+        u.step();
+        grid = reference_step(grid, cols, rows, torus, rule);
+        for (int y = 0; y < rows; y++)
+            for (int x = 0; x < cols; x++)
+                assert(u.get(x, y) == grid[y * cols + x]);
+    }
+    assert(u.generation() == (uint64_t)generations);
+}
+
+/* ---- Stepping ---- */
+
+TEST(test_blinker_oscillates) {
+    gol::Universe<> u(5, 5);
+    u.set(1, 2, ALIVE);
+    u.set(2, 2, ALIVE);
+    u.set(3, 2, ALIVE);
+    u.step();
+    assert(u.get(2, 1) == ALIVE && u.get(2, 2) == ALIVE && u.get(2, 3) == ALIVE);
+    assert(u.get(1, 2) == DEAD && u.population() == 3);
+    u.step();
+    assert(u.get(1, 2) == ALIVE && u.get(3, 2) == ALIVE && u.get(2, 1) == DEAD);
+}
+
+TEST(test_bytes_torus_matches_reference) {
+    check_against_reference<gol::Universe<gol::Bytes, gol::Conway, gol::Torus>>(23, 17, true, 12);
+    check_against_reference<gol::Universe<gol::Bytes, gol::HighLife, gol::Torus>>(9, 4, true, 12);
+}
+
+TEST(test_dead_edges_match_reference) {
+    check_against_reference<gol::Universe<gol::Bytes, gol::Conway, gol::DeadEdges>>(23, 17, false, 12);
+    check_against_reference<gol::Universe<gol::Bytes, gol::Conway, gol::DeadEdges, gol::Parallel>>(31, 29, false, 6);
+}
+
+TEST(test_bits_match_reference) {
+    check_against_reference<gol::Universe<gol::Bits>>(70, 13, true, 12);
+    check_against_reference<gol::Universe<gol::Bits, gol::HighLife>>(64, 8, true, 12);
+}
+
+TEST(test_parallel_matches_reference) {
+    check_against_reference<gol::Universe<gol::Bytes, gol::Conway, gol::Torus, gol::Parallel>>(40, 37, true, 8);
+}
+
+TEST(test_dynamic_rule_matches_static) {
+    gol::Universe<gol::Bytes, gol::HighLife> fixed(30, 20);
+    gol::Universe<gol::Bytes, gol::DynamicRule> dynamic(30, 20, gol::DynamicRule("B36/S23"));
+    random_fill(fixed, 5);
+    random_fill(dynamic, 5);
+    fixed.step(10);
+    dynamic.step(10);
+    for (int y = 0; y < 20; y++)
+        for (int x = 0; x < 30; x++)
+            assert(fixed.get(x, y) == dynamic.get(x, y));
+}
+
+TEST(test_invalid_arguments_throw) {
+    bool threw = false;
+    try {
+        gol::DynamicRule rule("B9/S");
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        gol::Universe<> u(0, 4);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+/* ---- Ownership and views ---- */
+
+TEST(test_row_views_alias_buffer) {
+    gol::Universe<> u(7, 3);
+    auto row = u.row(1);
+    assert(row.size() == 7);
+    row[4] = ALIVE;
+    assert(u.get(4, 1) == ALIVE);
+    assert(u.buffer().data() + 7 == row.data());
+
+    gol::Universe<gol::Bits> b(130, 2);
+    assert(b.row(1).size() == 3);
+    b.set(65, 1, ALIVE);
+    assert(b.row(1)[1] == 2);
+}
+
+TEST(test_move_transfers_buffers) {
+    gol::Universe<> a(12, 12);
+    a.set(3, 4, ALIVE);
+    const CellState *cells = a.buffer().data();
+    gol::Universe<> b(std::move(a));
+    assert(b.buffer().data() == cells);
+    assert(b.get(3, 4) == ALIVE);
+
+    gol::Universe<> c(2, 2);
+    c = std::move(b);
+    assert(c.buffer().data() == cells && c.cols() == 12);
+}
+
+TEST(test_step_does_not_allocate) {
+    gol::Universe<> bytes(64, 48);
+    gol::Universe<gol::Bits> bits(200, 50);
+    gol::Universe<gol::Bytes, gol::DynamicRule, gol::DeadEdges, gol::Parallel> parallel(64, 48);
+    random_fill(bytes, 1);
+    random_fill(bits, 2);
+    random_fill(parallel, 3);
+    parallel.step();  /* starts the worker pool */
+
+    size_t before = allocations;
+    bytes.step(20);
+    bits.step(20);
+    parallel.step(20);
+    assert(allocations == before);
+}
+
+TEST(test_universes_recycle_pooled_buffers) {
+    {
+        gol::Universe<gol::Bytes, gol::Conway, gol::DeadEdges> warm(90, 60);
+    }
+    GridPoolStats before, after;
+    grid_pool_stats(&before);
+    size_t allocated = allocations;
+    for (int i = 0; i < 100; i++) {
+        gol::Universe<gol::Bytes, gol::Conway, gol::DeadEdges> u(90, 60);
+        assert(u.population() == 0);
+        u.set(i % 90, i % 60, ALIVE);
+        u.step();
+        u.reset();
+        assert(u.population() == 0 && u.generation() == 0);
+    }
+    grid_pool_stats(&after);
+    assert(allocations == allocated);
+    assert(after.misses == before.misses && after.hits == before.hits + 300);
+}
+
+/* ---- Generation streams ---- */
+
+TEST(test_generations_match_step) {
+    gol::Universe<> streamed(33, 21);
+    gol::Universe<> stepped(33, 21);
+    random_fill(streamed, 9);
+    random_fill(stepped, 9);
+
+    uint64_t expected = 0;
+    for (const auto &gen : streamed.generations(15)) {
+        assert(gen.generation() == expected++);
+        for (int y = 0; y < 21; y++)
+            for (int x = 0; x < 33; x++)
+                assert(gen.get(x, y) == stepped.get(x, y));
+        stepped.step();
+    }
+    assert(expected == 15);
+    assert(streamed.generation() == 14);
+}
+
+TEST(test_generations_alternate_two_buffers) {
+    gol::Universe<gol::Bits> u(100, 40);
+    random_fill(u, 4);
+    const uint64_t *front = u.row(0).data();
+    const uint64_t *back = nullptr;
+    for (const auto &gen : u.generations(6)) {
+        const uint64_t *p = gen.row(0).data();
+        if (gen.generation() % 2 == 0) {
+            assert(p == front);
+        } else {
+            if (!back)
+                back = p;
+            assert(p == back && p != front);
+        }
+    }
+}
+
+TEST(test_generations_stop_early) {
+    gol::Universe<gol::Bytes, gol::Conway, gol::DeadEdges, gol::Parallel> u(50, 50);
+    random_fill(u, 6);
+    int seen = 0;
+    for (const auto &gen : u.generations()) {
+        if (++seen == 5)
+            break;
+        (void)gen;
+    }
+    /* The step computed ahead of the break is discarded. */
+    assert(u.generation() == 4);
+    u.step();
+    assert(u.generation() == 5);
+}
+
+TEST(test_generations_do_not_allocate_per_step) {
+    gol::Universe<> u(64, 64);
+    random_fill(u, 8);
+    size_t at_start = 0;
+    for (const auto &gen : u.generations(30)) {
+        if (gen.generation() == 0)
+            at_start = allocations;
+        else
+            assert(allocations == at_start);
+    }
+}
+
+/* ---- Asynchronous stepping ---- */
+
+TEST(test_step_async_matches_step) {
+    gol::Universe<gol::Bytes, gol::Conway, gol::Torus, gol::Parallel> async(45, 30);
+    gol::Universe<> sync(45, 30);
+    random_fill(async, 12);
+    random_fill(sync, 12);
+
+    /* The callback runs after the future is ready, so it can wait() on its own job */
+    std::promise<std::shared_ptr<gol::StepJob>> handle;
+    std::promise<std::pair<uint64_t, bool>> reported;
+    auto job = async.step_async(25, [&](uint64_t completed, bool cancelled) {
+        assert(handle.get_future().get()->wait() == completed);
+        reported.set_value({completed, cancelled});
+    });
+    handle.set_value(job);
+    assert(job->wait() == 25);
+    assert(job->done() && job->completed() == 25 && job->requested() == 25);
+    assert(reported.get_future().get() == std::make_pair(uint64_t{25}, false));
+
+    sync.step(25);
+    assert(async.generation() == 25);
+    for (int y = 0; y < 30; y++)
+        for (int x = 0; x < 45; x++)
+            assert(async.get(x, y) == sync.get(x, y));
+}
+
+TEST(test_step_async_cancel_and_progress) {
+    gol::Universe<> u(32, 32);
+    random_fill(u, 13);
+    auto job = u.step_async(1000000);
+    uint64_t last = 0;
+    while (job->completed() < 100) {
+        uint64_t now = job->completed();
+        assert(now >= last);
+        last = now;
+        std::this_thread::yield();
+    }
+    job->cancel();
+    uint64_t completed = job->future().get();
+    assert(job->cancelled() && completed >= 100 && completed < 1000000);
+    assert(u.generation() == completed && job->completed() == completed);
+}
+
+TEST(test_step_async_runs_without_handle) {
+    gol::Universe<gol::Bits> u(128, 16);
+    random_fill(u, 14);
+    std::promise<uint64_t> finished;
+    u.step_async(40, [&](uint64_t completed, bool) { finished.set_value(completed); }).reset();
+    assert(finished.get_future().get() == 40);
+}
+
+TEST(test_step_async_jobs_queue_in_order) {
+    gol::Universe<> a(20, 20), b(20, 20);
+    random_fill(a, 15);
+    random_fill(b, 15);
+    auto first = a.step_async(30);
+    auto second = a.step_async(12);
+    assert(second->wait() == 12 && first->done());
+    b.step(42);
+    for (int y = 0; y < 20; y++)
+        for (int x = 0; x < 20; x++)
+            assert(a.get(x, y) == b.get(x, y));
+}
+
+int main() {
+    printf("Running universe tests (C++)...\n\n");
+
+    printf("Stepping tests:\n");
+    RUN_TEST(test_blinker_oscillates);
+    RUN_TEST(test_bytes_torus_matches_reference);
+    RUN_TEST(test_dead_edges_match_reference);
+    RUN_TEST(test_bits_match_reference);
+    RUN_TEST(test_parallel_matches_reference);
+    RUN_TEST(test_dynamic_rule_matches_static);
+    RUN_TEST(test_invalid_arguments_throw);
+
+    printf("\nOwnership tests:\n");
+    RUN_TEST(test_row_views_alias_buffer);
+    RUN_TEST(test_move_transfers_buffers);
+    RUN_TEST(test_step_does_not_allocate);
+    RUN_TEST(test_universes_recycle_pooled_buffers);
+
+    printf("\nGeneration stream tests:\n");
+    RUN_TEST(test_generations_match_step);
+    RUN_TEST(test_generations_alternate_two_buffers);
+    RUN_TEST(test_generations_stop_early);
+    RUN_TEST(test_generations_do_not_allocate_per_step);
+
+    printf("\nAsync stepping tests:\n");
+    RUN_TEST(test_step_async_matches_step);
+    RUN_TEST(test_step_async_cancel_and_progress);
+    RUN_TEST(test_step_async_runs_without_handle);
+    RUN_TEST(test_step_async_jobs_queue_in_order);
+
+    parallel_shutdown();
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/*
+ * Tests for the Wireworld engine
+ * Compile: make test_wireworld
+ * Run: ./test_wireworld
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test_helpers.h"
+#include "wireworld.h"
+
+static void reference_step(const uint8_t *curr, uint8_t *next, int cols, int rows) {
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            uint8_t s = curr[y * cols + x];
+            if (s == WW_HEAD) {
+                s = WW_TAIL;
+            } else if (s == WW_TAIL) {
+                s = WW_CONDUCTOR;
+            } else if (s == WW_CONDUCTOR) {
+                int heads = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int nx = ((x + dx) % cols + cols) % cols, ny = ((y + dy) % rows + rows) % rows;
+                        heads += (dx || dy) && curr[ny * cols + nx] == WW_HEAD;
+                    }
+                }
+                if (heads == 1 || heads == 2)
+                    s = WW_HEAD;
+            }
+            next[y * cols + x] = s;
+        }
+    }
+}
+
+/* ' ' empty, '#' conductor, 'H' head, 't' tail */
+static void load_text(Wireworld *ww, const char **lines) {
+    uint8_t *cells = calloc((size_t)ww->cols * ww->rows, 1);
+    for (int y = 0; y < ww->rows && lines[y]; y++) {
+        for (int x = 0; x < ww->cols && lines[y][x]; x++) {
+            char c = lines[y][x];
+            cells[y * ww->cols + x] = c == '#' ? WW_CONDUCTOR : c == 'H' ? WW_HEAD : c == 't' ? WW_TAIL : WW_EMPTY;
+        }
+    }
+    wireworld_load(ww, cells);
+    free(cells);
+}
+
+static void check_random(int cols, int rows, int generations, int edit_every) {
+    Wireworld ww;
+    assert(wireworld_init(&ww, cols, rows) == 0);
+    size_t n = (size_t)cols * rows;
+    uint8_t *ref = malloc(n), *tmp = malloc(n);
+    srand(cols * 13 + rows);
+    for (size_t i = 0; i < n; i++) {
+        int r = rand() % 10;
+        ref[i] = r < 5 ? WW_CONDUCTOR : r == 5 ? WW_HEAD : r == 6 ? WW_TAIL : WW_EMPTY;
+    }
+    wireworld_load(&ww, ref);
+
+    for (int gen = 1; gen <= generations; gen++) {
+        wireworld_step(&ww);
+        reference_step(ref, tmp, cols, rows);
+        memcpy(ref, tmp, n);
+        assert(memcmp(ww.current_grid, ref, n) == 0);
+        if (edit_every && gen % edit_every == 0) {
+            int x = rand() % cols, y = rand() % rows;
+            uint8_t s = (uint8_t)(rand() % 4);
+            wireworld_set(&ww, x, y, s);
+            ref[y * cols + x] = s;
+        }
+    }
+    assert(ww.generation == generations);
+    free(ref); free(tmp);
+    wireworld_free(&ww);
+}
+
+TEST(test_matches_reference) {
+    check_random(30, 20, 60, 0);
+    check_random(7, 5, 40, 0);
+    check_random(1, 6, 10, 0);
+}
+
+TEST(test_edits_between_steps) {
+    check_random(25, 25, 80, 3);
+}
+
+TEST(test_electron_circles_torus) {
+    /* A wire spanning the torus: the electron is back after cols steps */
+    const char *lines[] = {
+        "       ",
+        "tH#####",
+        "       ",
+        NULL,
+    };
+    Wireworld ww;
+    assert(wireworld_init(&ww, 7, 3) == 0);
+    load_text(&ww, lines);
+    uint8_t start[21];
+    memcpy(start, ww.current_grid, sizeof(start));
+    for (int i = 0; i < 7; i++) {
+        wireworld_step(&ww);
+        assert(ww.n_heads == 1 && ww.n_tails == 1);
+        assert(wireworld_get(&ww, i + 2, 1) == WW_HEAD);
+        assert(i == 6 || memcmp(start, ww.current_grid, sizeof(start)) != 0);
+    }
+    assert(memcmp(start, ww.current_grid, sizeof(start)) == 0);
+    wireworld_free(&ww);
+}
+
+TEST(test_idle_board_stays_idle) {
+    const char *lines[] = {"#####", "#   #", "#####", NULL};
+    Wireworld ww;
+    assert(wireworld_init(&ww, 5, 3) == 0);
+    load_text(&ww, lines);
+    wireworld_step(&ww);
+    assert(ww.n_heads == 0 && ww.n_tails == 0);
+    assert(wireworld_get(&ww, 0, 0) == WW_CONDUCTOR);
+    assert(wireworld_get(&ww, -1, -1) == WW_CONDUCTOR);
+    assert(wireworld_get(&ww, 1, 1) == WW_EMPTY);
+    wireworld_free(&ww);
+}
+
+TEST(test_three_heads_block_birth) {
+    const char *lines[] = {
+        "     ",
+        " HHH ",
+        "  #  ",
+        "     ",
+        NULL,
+    };
+    Wireworld ww;
+    assert(wireworld_init(&ww, 5, 4) == 0);
+    load_text(&ww, lines);
+    wireworld_step(&ww);
+    assert(wireworld_get(&ww, 2, 2) == WW_CONDUCTOR);
+    assert(wireworld_get(&ww, 1, 1) == WW_TAIL);
+    wireworld_free(&ww);
+}
+
+int main(void) {
+    printf("Running Wireworld tests (C)...\n\n");
+
+    printf("Engine tests:\n");
+    RUN_TEST(test_matches_reference);
+    RUN_TEST(test_edits_between_steps);
+    RUN_TEST(test_electron_circles_torus);
+    RUN_TEST(test_idle_board_stays_idle);
+    RUN_TEST(test_three_heads_block_birth);
+
+    TEST_SUMMARY();
+    return tests_passed == tests_run ? 0 : 1;
+}